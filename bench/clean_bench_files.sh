@@ -0,0 +1,5 @@
+#!/bin/sh
+
+rm -rf work
+rm -f results.csv
+rm -f reorder.csv
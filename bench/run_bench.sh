@@ -0,0 +1,144 @@
+#!/bin/bash
+#
+# runs all tools on generated workloads for a matrix of sizes and thread
+# counts, writes wall time, peak rss and throughput to results.csv and
+# compares them against baseline.csv
+#
+#   ./run_bench.sh              run and compare against baseline.csv
+#   ./run_bench.sh --baseline   run and store results as baseline.csv
+#
+# environment:
+#   BENCH_SIZES       sizes to run [default="small medium large"]
+#   BENCH_THREADS     thread counts of failureProbabilityByMcs [default="1 2 4"]
+#   BENCH_REPEAT      runs of each measurement, the fastest counts [default=3]
+#   BENCH_TOLERANCE   allowed relative slowdown [default=0.25]
+#   BENCH_MIN_SECONDS slowdowns below this are noise [default=0.1]
+
+BIN=../bin
+WORK=work
+RESULTS=results.csv
+BASELINE=baseline.csv
+SIZES=${BENCH_SIZES:-small medium large}
+THREADS=${BENCH_THREADS:-1 2 4}
+REPEAT=${BENCH_REPEAT:-3}
+TOLERANCE=${BENCH_TOLERANCE:-0.25}
+MIN_SECONDS=${BENCH_MIN_SECONDS:-0.1}
+
+# workloads: reactions, rows, cardinalities and maximum knockouts of the mcs
+# and reactions and rows of the efms
+declare -A MCS_RX=( [small]=200 [medium]=400 [large]=800 )
+declare -A MCS_ROWS=( [small]=10000 [medium]=25000 [large]=50000 )
+declare -A MCS_CARDS=( [small]=2-6 [medium]=2-7 [large]=2-8 )
+declare -A MCS_MAX=( [small]=3 [medium]=3 [large]=3 )
+declare -A EFM_RX=( [small]=60 [medium]=100 [large]=150 )
+declare -A EFM_ROWS=( [small]=20000 [medium]=100000 [large]=300000 )
+
+mkdir -p $WORK
+
+# runs command once, sets WALL in seconds and RSS in KB
+# peak rss is taken from GNU time if it is installed, otherwise the high
+# water mark of the process is sampled while it runs
+measureOnce() {
+    local start=$(date +%s%N)
+    if [ -x /usr/bin/time ]; then
+        /usr/bin/time -f "%M" -o $WORK/rss "$@" > $WORK/stdout || exit 1
+        RSS=$(tail -n 1 $WORK/rss)
+    else
+        "$@" > $WORK/stdout &
+        local pid=$!
+        local hwm
+        RSS=0
+        while kill -0 $pid 2> /dev/null; do
+            hwm=$(awk '/VmHWM/ {print $2}' /proc/$pid/status 2> /dev/null)
+            if [ -n "$hwm" ]; then
+                RSS=$hwm
+            fi
+            sleep 0.02
+        done
+        wait $pid || exit 1
+    fi
+    local stop=$(date +%s%N)
+    WALL=$(awk -v ns=$(( stop - start )) 'BEGIN {printf "%.3f", ns / 1e9}')
+}
+
+# runs command REPEAT times, sets WALL to the fastest run and RSS to the
+# highest peak
+measure() {
+    local best_wall best_rss i
+    for (( i = 0; i < REPEAT; i++ )); do
+        measureOnce "$@"
+        if [ $i -eq 0 ] || awk -v a=$WALL -v b=$best_wall 'BEGIN {exit !(a < b)}'
+        then
+            best_wall=$WALL
+        fi
+        if [ $i -eq 0 ] || [ $RSS -gt $best_rss ]; then
+            best_rss=$RSS
+        fi
+    done
+    WALL=$best_wall
+    RSS=$best_rss
+}
+
+# appends measurement of tool to results
+record() {
+    local tool=$1 size=$2 threads=$3 rows=$4 unit=$5
+    local rate=$(awk -v r=$rows -v w=$WALL \
+        'BEGIN {printf "%.1f", (w > 0) ? r / w : 0}')
+    echo "$tool,$size,$threads,$rows,$WALL,$RSS,$rate,$unit" >> $RESULTS
+    printf "%-26s %-7s %3s threads %9s s %9s KB %12s %s\n" $tool $size \
+        $threads $WALL $RSS $rate $unit
+}
+
+echo "tool,size,threads,rows,wall_s,peak_rss_kb,throughput,unit" > $RESULTS
+for size in $SIZES; do
+    mcs=$WORK/$size.cutsets
+    efm=$WORK/$size.efms
+    if [ ! -f $mcs ]; then
+        $BIN/generateWorkload -k mcs -r ${MCS_RX[$size]} -n ${MCS_ROWS[$size]} \
+            -c ${MCS_CARDS[$size]} -s 1 -o $mcs || exit 1
+    fi
+    if [ ! -f $efm ]; then
+        $BIN/generateWorkload -k efm -r ${EFM_RX[$size]} -n ${EFM_ROWS[$size]} \
+            -c 5-40 -q 0.95 -s 1 -o $efm || exit 1
+    fi
+    for threads in $THREADS; do
+        measure $BIN/failureProbabilityByMcs -i $mcs -m ${MCS_MAX[$size]} \
+            -t $threads -o $WORK/$size.fp.out
+        record failureProbabilityByMcs $size $threads ${MCS_ROWS[$size]} mcs/s
+    done
+    lines=$(wc -l < $WORK/$size.fp.out)
+    measure $BIN/recalcFailureProbability -i $WORK/$size.fp.out -l 0.1
+    record recalcFailureProbability $size 1 $lines lines/s
+    measure $BIN/robustnessByEfms -i $efm
+    record robustnessByEfms $size 1 ${EFM_ROWS[$size]} efm/s
+    measure $BIN/overallRobustnessByEfms -i $efm
+    record overallRobustnessByEfms $size 1 ${EFM_ROWS[$size]} efm/s
+done
+
+if [ "$1" == "--baseline" ]; then
+    cp $RESULTS $BASELINE
+    echo "baseline stored in $BASELINE"
+    exit 0
+fi
+if [ ! -f $BASELINE ]; then
+    echo "no baseline found, store one by ./run_bench.sh --baseline"
+    exit 0
+fi
+
+# flag runs that are slower than the baseline by more than the tolerance
+awk -F, -v tol=$TOLERANCE -v min=$MIN_SECONDS '
+    FNR == 1 { next }
+    FNR == NR { base[$1 "," $2 "," $3] = $5; next }
+    ($1 "," $2 "," $3) in base {
+        b = base[$1 "," $2 "," $3]
+        compared++
+        if ( ($5 > b * (1 + tol)) && ($5 - b > min) ) {
+            printf "REGRESSION %s %s %s threads: %.3f s -> %.3f s\n", \
+                $1, $2, $3, b, $5
+            slower++
+        }
+    }
+    END {
+        printf "%d of %d runs slower than baseline\n", slower, compared
+        exit slower > 0
+    }' $BASELINE $RESULTS
@@ -0,0 +1,78 @@
+#!/bin/bash
+#
+# runs regression checks of the tools on generated workloads and exits with
+# the number of failed checks
+#
+#   ./run_checks.sh
+
+BIN=../bin
+WORK=work
+FAILED=0
+
+mkdir -p $WORK
+
+# reports result of a check
+report() {
+    local name=$1 status=$2
+    if [ $status -eq 0 ]; then
+        echo "ok     $name"
+    else
+        echo "FAILED $name"
+        FAILED=$(( FAILED + 1 ))
+    fi
+}
+
+# many reactions without -m: the binomial table has to be sized by the
+# number of knockouts left by the 128 bit limit, not by the reactions
+checkWideInput() {
+    local mcs=$WORK/wide.cutsets
+    $BIN/generateWorkload -k mcs -r 7000 -n 200 -c 2-4 -s 1 -o $mcs \
+        > /dev/null || return 1
+    ( ulimit -v 262144; $BIN/failureProbabilityByMcs -i $mcs \
+        -o $WORK/wide.fp.out > /dev/null 2>&1 ) || return 1
+    grep -q "^total P(f)" $WORK/wide.fp.out
+}
+
+# a run killed after its first checkpoints and resumed from them gives the
+# same table as an uninterrupted run
+checkResume() {
+    local mcs=$WORK/resume.cutsets
+    local ckpt=$WORK/resume.ckpt
+    $BIN/generateWorkload -k mcs -r 200 -n 3000 -c 2-5 -s 2 -o $mcs \
+        > /dev/null || return 1
+    $BIN/failureProbabilityByMcs -i $mcs -m 4 -o $WORK/resume.full.out \
+        > /dev/null 2>&1 || return 1
+    rm -f $ckpt
+    $BIN/failureProbabilityByMcs -i $mcs -m 4 -o $WORK/resume.part.out \
+        --checkpoint $ckpt --checkpoint-interval 1 > /dev/null 2>&1 &
+    local pid=$!
+    sleep 3
+    kill -9 $pid 2> /dev/null || return 1
+    wait $pid 2> /dev/null
+    [ -f $ckpt ] || return 1
+    $BIN/failureProbabilityByMcs -i $mcs -o $WORK/resume.out --resume $ckpt \
+        > /dev/null 2>&1 || return 1
+    cmp -s $WORK/resume.full.out $WORK/resume.out
+}
+
+# mcs of one reaction are counted as single knockouts apart from the
+# reduced matrix, search and decision diagram have to agree on them
+checkSingleKnockouts() {
+    local mcs=$WORK/single.cutsets
+    $BIN/generateWorkload -k mcs -r 80 -n 600 -c 1-4 -q 4 -s 3 -o $mcs \
+        > /dev/null || return 1
+    $BIN/failureProbabilityByMcs -i $mcs -m 5 -o $WORK/single.search.out \
+        > /dev/null 2>&1 || return 1
+    $BIN/failureProbabilityByMcs -i $mcs -m 5 --engine zdd \
+        -o $WORK/single.zdd.out > /dev/null 2>&1 || return 1
+    cmp -s $WORK/single.search.out $WORK/single.zdd.out
+}
+
+checkWideInput
+report "wide input without -m in 256 MB" $?
+checkResume
+report "resume after interrupt" $?
+checkSingleKnockouts
+report "single knockouts by search and zdd" $?
+
+exit $FAILED
@@ -0,0 +1,79 @@
+#!/bin/bash
+#
+# compares the orders of the reduced matrix of failureProbabilityByMcs
+# --reorder on the example network and on generated workloads, writes wall
+# time of each order to reorder.csv and checks that all orders give the
+# same result
+#
+#   ./run_reorder_bench.sh
+#
+# environment:
+#   BENCH_ORDERS      orders to run [default="none columns rows both"]
+#   BENCH_THREADS     threads of failureProbabilityByMcs [default=1]
+#   BENCH_REPEAT      runs of each measurement, the fastest counts [default=3]
+
+BIN=../bin
+WORK=work
+RESULTS=reorder.csv
+ORDERS=${BENCH_ORDERS:-none columns rows both}
+THREADS=${BENCH_THREADS:-1}
+REPEAT=${BENCH_REPEAT:-3}
+
+# inputs: file, maximum knockouts and generateWorkload arguments of
+# generated files
+INPUTS="example small medium large dense"
+declare -A MCS_MAX=( [example]=10 [small]=3 [medium]=3 [large]=3 [dense]=4 )
+declare -A MCS_ARGS=(
+    [small]="-r 200 -n 10000 -c 2-6"
+    [medium]="-r 400 -n 25000 -c 2-7"
+    [large]="-r 800 -n 50000 -c 2-8"
+    [dense]="-r 120 -n 3000 -c 2-5 -h 0.6" )
+
+mkdir -p $WORK
+
+# runs command REPEAT times, sets WALL to the fastest run in seconds
+measure() {
+    local i start stop wall
+    WALL=
+    for (( i = 0; i < REPEAT; i++ )); do
+        start=$(date +%s%N)
+        "$@" > $WORK/stdout 2> /dev/null || exit 1
+        stop=$(date +%s%N)
+        wall=$(awk -v ns=$(( stop - start )) 'BEGIN {printf "%.3f", ns / 1e9}')
+        if [ -z "$WALL" ] || awk -v a=$wall -v b=$WALL 'BEGIN {exit !(a < b)}'
+        then
+            WALL=$wall
+        fi
+    done
+}
+
+echo "input,order,threads,max_card,wall_s,speedup" > $RESULTS
+failed=0
+for input in $INPUTS; do
+    mcs=$WORK/reorder_$input.cutsets
+    if [ $input == example ]; then
+        mcs=../examples/example.cutsets
+    elif [ ! -f $mcs ]; then
+        $BIN/generateWorkload -k mcs ${MCS_ARGS[$input]} -s 1 -o $mcs || exit 1
+    fi
+    base=
+    for order in $ORDERS; do
+        out=$WORK/reorder_$input.$order.out
+        measure $BIN/failureProbabilityByMcs -i $mcs -m ${MCS_MAX[$input]} \
+            -t $THREADS --reorder $order -o $out
+        if [ -z "$base" ]; then
+            base=$WALL
+            ref=$out
+        elif ! diff -q $ref $out > /dev/null; then
+            echo "RESULT DIFFERS $input $order"
+            failed=1
+        fi
+        speedup=$(awk -v b=$base -v w=$WALL \
+            'BEGIN {printf "%.2f", (w > 0) ? b / w : 0}')
+        echo "$input,$order,$THREADS,${MCS_MAX[$input]},$WALL,$speedup" \
+            >> $RESULTS
+        printf "%-8s %-8s %3s threads  -m %2s %9s s %6sx\n" $input $order \
+            $THREADS ${MCS_MAX[$input]} $WALL $speedup
+    done
+done
+exit $failed
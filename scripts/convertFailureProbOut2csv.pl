@@ -68,8 +68,6 @@ if ( $opt{h} or !$opt{i} ){
 my $in = readFile($opt{i});
 my $inData = 0;
 
-print "n,d,Pf.weighted,Pf,cutsets.total,cutsets.possible\n";
-
 for (my $i = 0; $i < @{$in}; $i++) {
 	if ($inData)
 	{
@@ -82,6 +80,20 @@ for (my $i = 0; $i < @{$in}; $i++) {
 			chomp($in->[$i]);
             $in->[$i] =~ s/^\s+//;
 			my @spl = split(/\s+/, $in->[$i]);
+			# sampled outputs bound P(f) by two more columns
+			if ($inData == 1)
+			{
+				print "n,d,Pf.weighted,Pf,cutsets.total,cutsets.possible";
+				print ",Pf.low,Pf.high,estimated" if (@spl == 8);
+				print "\n";
+				$inData = 2;
+			}
+			# estimated cutsets of sampled rows are marked by ~, the mark
+			# becomes the column estimated
+			if (@spl == 8)
+			{
+				push(@spl, ($spl[4] =~ s/^~//) ? 1 : 0);
+			}
 			print join(',', @spl);
 			print "\n";
 		}
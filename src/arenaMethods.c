@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+
+#define ARENA_ALIGN 64
+
+// block of an arena, the memory handed out follows the header
+struct arena_block
+{
+    struct arena_block* prev;
+    struct arena_block* next;
+    size_t              size;
+    size_t              used;
+};
+
+// stack allocator of one thread
+// memory is handed out by bumping a pointer and released in LIFO order
+// blocks are kept after release and reused by later allocations
+struct arena
+{
+    struct arena_block* current;
+    size_t              block_size;
+    size_t              used;
+    size_t              peak;
+};
+
+// position in an arena to return to
+struct arena_mark
+{
+    struct arena_block* block;
+    size_t              block_used;
+    size_t              used;
+};
+
+int initArena(struct arena* arena, size_t block_size);
+void freeArena(struct arena* arena);
+void* arenaAlloc(struct arena* arena, size_t size);
+struct arena_mark arenaMark(struct arena* arena);
+void arenaRelease(struct arena* arena, struct arena_mark mark);
+struct arena_block* newArenaBlock(size_t size);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  newArenaBlock
+ *  Description:  allocates a block with size usable bytes
+ *                returns NULL if there is not enough free memory
+ * =====================================================================================
+ */
+    struct arena_block*
+newArenaBlock(size_t size)
+{
+    struct arena_block* block = NULL;
+    if (posix_memalign((void**)&block, ARENA_ALIGN, ARENA_ALIGN + size))
+    {
+        return NULL;
+    }
+    block->prev = NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}		/* -----  end of function newArenaBlock  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initArena
+ *  Description:  prepares an arena with a first block of block_size bytes
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+initArena(struct arena* arena, size_t block_size)
+{
+    arena->block_size = block_size;
+    arena->used       = 0;
+    arena->peak       = 0;
+    arena->current    = newArenaBlock(block_size);
+    return arena->current != NULL;
+}		/* -----  end of function initArena  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeArena
+ *  Description:  frees all blocks of an arena
+ * =====================================================================================
+ */
+    void
+freeArena(struct arena* arena)
+{
+    struct arena_block* block = arena->current;
+    while (block && block->prev)
+    {
+        block = block->prev;
+    }
+    while (block)
+    {
+        struct arena_block* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->current = NULL;
+}		/* -----  end of function freeArena  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  arenaAlloc
+ *  Description:  returns size bytes aligned to ARENA_ALIGN, memory is not
+ *                cleared
+ *                returns NULL if there is not enough free memory
+ * =====================================================================================
+ */
+    void*
+arenaAlloc(struct arena* arena, size_t size)
+{
+    size = (size + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+    struct arena_block* block = arena->current;
+    if (block->used + size > block->size)
+    {
+        // continue in the next block, replace it if it is too small
+        struct arena_block* next = block->next;
+        if (next && next->size < size)
+        {
+            block->next = NULL;
+            while (next)
+            {
+                struct arena_block* tmp = next->next;
+                free(next);
+                next = tmp;
+            }
+        }
+        if (!next)
+        {
+            next = newArenaBlock(size > arena->block_size ? size :
+                    arena->block_size);
+            if (!next)
+            {
+                return NULL;
+            }
+            next->prev  = block;
+            block->next = next;
+        }
+        next->used     = 0;
+        block          = next;
+        arena->current = block;
+    }
+    void* ptr = (char*)block + ARENA_ALIGN + block->used;
+    block->used += size;
+    arena->used += size;
+    if (arena->used > arena->peak)
+    {
+        arena->peak = arena->used;
+    }
+    return ptr;
+}		/* -----  end of function arenaAlloc  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  arenaMark
+ *  Description:  returns the actual position of an arena
+ * =====================================================================================
+ */
+    struct arena_mark
+arenaMark(struct arena* arena)
+{
+    struct arena_mark mark;
+    mark.block      = arena->current;
+    mark.block_used = arena->current->used;
+    mark.used       = arena->used;
+    return mark;
+}		/* -----  end of function arenaMark  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  arenaRelease
+ *  Description:  releases all memory allocated after mark was taken
+ * =====================================================================================
+ */
+    void
+arenaRelease(struct arena* arena, struct arena_mark mark)
+{
+    arena->current       = mark.block;
+    arena->current->used = mark.block_used;
+    arena->used          = mark.used;
+}		/* -----  end of function arenaRelease  ----- */
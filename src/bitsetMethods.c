@@ -0,0 +1,460 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BITSET_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#define WORDBITS        64
+#define WORDMASK(b)     ((uint64_t)1 << ((b) % WORDBITS))
+#define WORDSLOT(b)     ((b) / WORDBITS)
+#define WORDSET(a, b)   ((a)[WORDSLOT(b)] |= WORDMASK(b))
+#define WORDCLEAR(a, b) ((a)[WORDSLOT(b)] &= ~WORDMASK(b))
+#define WORDTEST(a, b)  ((a)[WORDSLOT(b)] & WORDMASK(b))
+#define WORDNSLOTS(nb)  (((nb) + WORDBITS - 1) / WORDBITS)
+
+// rows of a bitset slab are stored one after another with a fixed stride
+#define SLAB_ALIGN      64
+#define SLABROW(s, r, w) ((s) + (unsigned long)(r) * (w))
+
+typedef uint64_t bitword;
+
+int getWordCount(int bit_count);
+int bitsetIntersects(const bitword* a, const bitword* b, int words);
+int bitsetCountAndNot(const bitword* a, const bitword* b, int words);
+int bitsetFirstAndNot(const bitword* a, const bitword* b, int words);
+int bitsetCount(const bitword* a, int words);
+void bitsetOr(bitword* dst, const bitword* a, const bitword* b, int words);
+void bitsetCopy(bitword* dst, const bitword* src, int words);
+bitword* newBitsetSlab(unsigned long rows, int words);
+unsigned long bitsetNextClear(const bitword* a, unsigned long from, unsigned
+        long end);
+int setBitsetKernel(char* name);
+void initBitsetKernels(void);
+
+// kernels used in the hot loop of the cutset search
+// the fastest version supported by the running cpu is chosen at startup
+int (*bitsetIntersectsKernel)(const bitword*, const bitword*, int) =
+    bitsetIntersects;
+int (*bitsetCountAndNotKernel)(const bitword*, const bitword*, int) =
+    bitsetCountAndNot;
+char* bitsetKernelName = "scalar";
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getWordCount
+ *  Description:  returns number of 64 bit words needed to store bit_count bits
+ * =====================================================================================
+ */
+    int
+getWordCount(int bit_count)
+{
+    return WORDNSLOTS(bit_count);
+}		/* -----  end of function getWordCount  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetIntersects
+ *  Description:  returns 1 if a and b have at least one common bit
+ * =====================================================================================
+ */
+    int
+bitsetIntersects(const bitword* a, const bitword* b, int words)
+{
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        if (a[i] & b[i])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function bitsetIntersects  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetCountAndNot
+ *  Description:  returns number of bits set in a but not in b
+ * =====================================================================================
+ */
+    int
+bitsetCountAndNot(const bitword* a, const bitword* b, int words)
+{
+    int count = 0;
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        count += __builtin_popcountll(a[i] & ~b[i]);
+    }
+    return count;
+}		/* -----  end of function bitsetCountAndNot  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetFirstAndNot
+ *  Description:  returns index of the first bit set in a but not in b
+ *                returns -1 if there is no such bit
+ * =====================================================================================
+ */
+    int
+bitsetFirstAndNot(const bitword* a, const bitword* b, int words)
+{
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        bitword w = a[i] & ~b[i];
+        if (w)
+        {
+            return i * WORDBITS + __builtin_ctzll(w);
+        }
+    }
+    return -1;
+}		/* -----  end of function bitsetFirstAndNot  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetCount
+ *  Description:  returns number of set bits
+ * =====================================================================================
+ */
+    int
+bitsetCount(const bitword* a, int words)
+{
+    int count = 0;
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        count += __builtin_popcountll(a[i]);
+    }
+    return count;
+}		/* -----  end of function bitsetCount  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetOr
+ *  Description:  stores union of a and b in dst
+ * =====================================================================================
+ */
+    void
+bitsetOr(bitword* dst, const bitword* a, const bitword* b, int words)
+{
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        dst[i] = a[i] | b[i];
+    }
+}		/* -----  end of function bitsetOr  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetCopy
+ *  Description:  copies src to dst
+ * =====================================================================================
+ */
+    void
+bitsetCopy(bitword* dst, const bitword* src, int words)
+{
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        dst[i] = src[i];
+    }
+}		/* -----  end of function bitsetCopy  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetNextClear
+ *  Description:  returns position of the first bit >= from that is not set in
+ *                a or end if all bits up to end are set
+ * =====================================================================================
+ */
+    unsigned long
+bitsetNextClear(const bitword* a, unsigned long from, unsigned long end)
+{
+    while (from < end)
+    {
+        bitword bits = ~a[WORDSLOT(from)] >> (from % WORDBITS);
+        if (bits)
+        {
+            from += __builtin_ctzll(bits);
+            return from < end ? from : end;
+        }
+        from = (WORDSLOT(from) + 1) * WORDBITS;
+    }
+    return end;
+}		/* -----  end of function bitsetNextClear  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  newBitsetSlab
+ *  Description:  allocates one zeroed block for rows bitsets of given words,
+ *                aligned to a cache line, row r starts at SLABROW(slab, r, words)
+ *                returns NULL if there is not enough memory, free with free()
+ * =====================================================================================
+ */
+    bitword*
+newBitsetSlab(unsigned long rows, int words)
+{
+    size_t size = rows * words * sizeof(bitword);
+    void*  slab = NULL;
+    if (posix_memalign(&slab, SLAB_ALIGN, size > 0 ? size : SLAB_ALIGN))
+    {
+        return NULL;
+    }
+    memset(slab, 0, size);
+    return slab;
+}		/* -----  end of function newBitsetSlab  ----- */
+
+#ifdef BITSET_X86_KERNELS
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetCountAndNotPopcnt
+ *  Description:  bitsetCountAndNot for cpus with popcnt instruction
+ *                the overlap test needs no popcount, the popcnt kernel uses
+ *                bitsetIntersects for it
+ * =====================================================================================
+ */
+    __attribute__((target("popcnt"))) int
+bitsetCountAndNotPopcnt(const bitword* a, const bitword* b, int words)
+{
+    int count = 0;
+    int i;
+    for (i = 0; i < words; i++)
+    {
+        count += _mm_popcnt_u64(a[i] & ~b[i]);
+    }
+    return count;
+}		/* -----  end of function bitsetCountAndNotPopcnt  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetIntersectsAvx2
+ *  Description:  bitsetIntersects testing 4 words at once
+ * =====================================================================================
+ */
+    __attribute__((target("avx2,popcnt"))) int
+bitsetIntersectsAvx2(const bitword* a, const bitword* b, int words)
+{
+    int i = 0;
+    for (i = 0; i + 4 <= words; i += 4)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        if (!_mm256_testz_si256(va, vb))
+        {
+            return 1;
+        }
+    }
+    for (; i < words; i++)
+    {
+        if (a[i] & b[i])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function bitsetIntersectsAvx2  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetCountAndNotAvx2
+ *  Description:  bitsetCountAndNot counting 4 words at once
+ *                bits are counted by a nibble lookup table (AVX2 has no
+ *                vector popcount)
+ * =====================================================================================
+ */
+    __attribute__((target("avx2,popcnt"))) int
+bitsetCountAndNotAvx2(const bitword* a, const bitword* b, int words)
+{
+    const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (i = 0; i + 4 <= words; i += 4)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i v  = _mm256_andnot_si256(vb, va);
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt,
+                    _mm256_setzero_si256()));
+    }
+    int count = (int)(_mm256_extract_epi64(acc, 0) +
+            _mm256_extract_epi64(acc, 1) + _mm256_extract_epi64(acc, 2) +
+            _mm256_extract_epi64(acc, 3));
+    for (; i < words; i++)
+    {
+        count += _mm_popcnt_u64(a[i] & ~b[i]);
+    }
+    return count;
+}		/* -----  end of function bitsetCountAndNotAvx2  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetIntersectsAvx512
+ *  Description:  bitsetIntersects testing 8 words at once
+ * =====================================================================================
+ */
+    __attribute__((target("avx512f"))) int
+bitsetIntersectsAvx512(const bitword* a, const bitword* b, int words)
+{
+    int i;
+    for (i = 0; i < words; i += 8)
+    {
+        __mmask8 m = (words - i >= 8) ? 0xFF : (__mmask8)((1u << (words - i))
+                - 1);
+        __m512i va = _mm512_maskz_loadu_epi64(m, a + i);
+        __m512i vb = _mm512_maskz_loadu_epi64(m, b + i);
+        if (_mm512_test_epi64_mask(va, vb))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function bitsetIntersectsAvx512  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  bitsetCountAndNotAvx512
+ *  Description:  bitsetCountAndNot counting 8 words at once with VPOPCNTQ
+ * =====================================================================================
+ */
+    __attribute__((target("avx512f,avx512vpopcntdq"))) int
+bitsetCountAndNotAvx512(const bitword* a, const bitword* b, int words)
+{
+    __m512i acc = _mm512_setzero_si512();
+    int i;
+    for (i = 0; i < words; i += 8)
+    {
+        __mmask8 m = (words - i >= 8) ? 0xFF : (__mmask8)((1u << (words - i))
+                - 1);
+        __m512i va = _mm512_maskz_loadu_epi64(m, a + i);
+        __m512i vb = _mm512_maskz_loadu_epi64(m, b + i);
+        acc = _mm512_add_epi64(acc,
+                _mm512_popcnt_epi64(_mm512_andnot_si512(vb, va)));
+    }
+    return (int)_mm512_reduce_add_epi64(acc);
+}		/* -----  end of function bitsetCountAndNotAvx512  ----- */
+#endif
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  setBitsetKernel
+ *  Description:  selects kernels by name (scalar, popcnt, avx2, avx512)
+ *                returns 0 if the kernel is unknown or not supported by the cpu
+ * =====================================================================================
+ */
+    int
+setBitsetKernel(char* name)
+{
+    if (!strcmp(name, "scalar"))
+    {
+        bitsetIntersectsKernel  = bitsetIntersects;
+        bitsetCountAndNotKernel = bitsetCountAndNot;
+        bitsetKernelName        = "scalar";
+        return 1;
+    }
+#ifdef BITSET_X86_KERNELS
+    __builtin_cpu_init();
+    if (!strcmp(name, "popcnt") && __builtin_cpu_supports("popcnt"))
+    {
+        bitsetIntersectsKernel  = bitsetIntersects;
+        bitsetCountAndNotKernel = bitsetCountAndNotPopcnt;
+        bitsetKernelName        = "popcnt";
+        return 1;
+    }
+    if (!strcmp(name, "avx2") && __builtin_cpu_supports("avx2") &&
+            __builtin_cpu_supports("popcnt"))
+    {
+        bitsetIntersectsKernel  = bitsetIntersectsAvx2;
+        bitsetCountAndNotKernel = bitsetCountAndNotAvx2;
+        bitsetKernelName        = "avx2";
+        return 1;
+    }
+    if (!strcmp(name, "avx512") && __builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512vpopcntdq"))
+    {
+        bitsetIntersectsKernel  = bitsetIntersectsAvx512;
+        bitsetCountAndNotKernel = bitsetCountAndNotAvx512;
+        bitsetKernelName        = "avx512";
+        return 1;
+    }
+#endif
+    return 0;
+}		/* -----  end of function setBitsetKernel  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initBitsetKernels
+ *  Description:  selects the fastest kernels supported by the cpu
+ * =====================================================================================
+ */
+    void
+initBitsetKernels(void)
+{
+    if (!setBitsetKernel("avx512") && !setBitsetKernel("avx2") &&
+            !setBitsetKernel("popcnt"))
+    {
+        setBitsetKernel("scalar");
+    }
+}		/* -----  end of function initBitsetKernels  ----- */
@@ -0,0 +1,272 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CKPT_OK           0
+#define CKPT_ERROR_FILE   1
+#define CKPT_ERROR_RAM    2
+#define CKPT_ERROR_FORMAT 3
+
+#define CKPT_MAGIC        "NRTCKPT"
+#define CKPT_VERSION      1
+
+// header of checkpoint files, all numbers in byte order of the machine
+// the header is followed by
+//   - uint16_t row_cards[row_count]: number of cardinalities whose cutsets
+//     of the mcs are complete
+//   - uint128 cutsets[row_count * max_card]: cutsets of mcs li and
+//     cardinality card at li * max_card + card, only cardinalities below
+//     row_cards[li] are valid
+// hash identifies the reduced mcs, rows are the first row_count mcs of the
+// reduced matrix
+struct ckpt_header
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t max_card;
+    uint64_t hash;
+    uint64_t rx_count;
+    uint64_t red_rx_count;
+    uint64_t row_count;
+};
+
+// cutset counts of a run of failureProbabilityByMcs
+struct checkpoint
+{
+    uint64_t      hash;
+    int           rx_count;
+    int           red_rx_count;
+    int           max_card;
+    unsigned long row_count;
+    uint16_t*     row_cards;
+    uint128*      cutsets;
+};
+
+uint64_t hashMcsRows(bitword* mat, unsigned long row_count, int word_count,
+        unsigned long* mcs_card_sum, int rx_count);
+int writeCheckpoint(char* filename, struct checkpoint* ckpt);
+int readCheckpoint(char* filename, struct checkpoint* ckpt);
+void freeCheckpoint(struct checkpoint* ckpt);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  hashMcsRows
+ *  Description:  returns a 64 bit hash of the number of mcs of each
+ *                cardinality and the first row_count rows of the reduced
+ *                matrix mat
+ * =====================================================================================
+ */
+    uint64_t
+hashMcsRows(bitword* mat, unsigned long row_count, int word_count, unsigned
+        long* mcs_card_sum, int rx_count)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    unsigned long li;
+    for (li = 0; li < (unsigned long)rx_count + row_count * word_count; li++)
+    {
+        uint64_t value = li < (unsigned long)rx_count ? mcs_card_sum[li] : mat[li - rx_count];
+        hash ^= value;
+        hash *= 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}		/* -----  end of function hashMcsRows  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeCheckpoint
+ *  Description:  writes a checkpoint to a temporary file that replaces
+ *                filename when it is complete
+ *                row_cards may be raised by other threads while writing,
+ *                only cutsets of complete cardinalities are read
+ *                returns CKPT_OK, CKPT_ERROR_FILE or CKPT_ERROR_RAM
+ * =====================================================================================
+ */
+    int
+writeCheckpoint(char* filename, struct checkpoint* ckpt)
+{
+    size_t    name_length = strlen(filename);
+    char*     tmp_name    = malloc(name_length + 5);
+    uint16_t* row_cards   = malloc((ckpt->row_count + 1) * sizeof(uint16_t));
+    uint128*  row         = malloc(ckpt->max_card * sizeof(uint128));
+    if ( (NULL == tmp_name) || (NULL == row_cards) || (NULL == row) )
+    {
+        free(tmp_name);
+        free(row_cards);
+        free(row);
+        return CKPT_ERROR_RAM;
+    }
+    memcpy(tmp_name, filename, name_length);
+    memcpy(tmp_name + name_length, ".tmp", 5);
+
+    struct ckpt_header header;
+    memset(&header, 0, sizeof(struct ckpt_header));
+    memcpy(header.magic, CKPT_MAGIC, sizeof(CKPT_MAGIC));
+    header.version      = CKPT_VERSION;
+    header.max_card     = ckpt->max_card;
+    header.hash         = ckpt->hash;
+    header.rx_count     = ckpt->rx_count;
+    header.red_rx_count = ckpt->red_rx_count;
+    header.row_count    = ckpt->row_count;
+
+    // take the complete cardinalities once, the cutsets below are final
+    unsigned long li;
+    for (li = 0; li < ckpt->row_count; li++)
+    {
+        row_cards[li] = __atomic_load_n(&ckpt->row_cards[li],
+                __ATOMIC_ACQUIRE);
+    }
+
+    FILE* out = fopen(tmp_name, "wb");
+    int   ok  = out != NULL;
+    ok = ok && fwrite(&header, sizeof(struct ckpt_header), 1, out) == 1;
+    ok = ok && fwrite(row_cards, sizeof(uint16_t), ckpt->row_count, out) ==
+        ckpt->row_count;
+    for (li = 0; ok && (li < ckpt->row_count); li++)
+    {
+        memset(row, 0, ckpt->max_card * sizeof(uint128));
+        memcpy(row, ckpt->cutsets + li * ckpt->max_card, row_cards[li] *
+                sizeof(uint128));
+        ok = fwrite(row, sizeof(uint128), ckpt->max_card, out) ==
+            (size_t)ckpt->max_card;
+    }
+    if (out)
+    {
+        ok = !fclose(out) && ok;
+    }
+    ok = ok && !rename(tmp_name, filename);
+    free(tmp_name);
+    free(row_cards);
+    free(row);
+    return ok ? CKPT_OK : CKPT_ERROR_FILE;
+}		/* -----  end of function writeCheckpoint  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  readCheckpoint
+ *  Description:  reads a checkpoint written by writeCheckpoint
+ *                returns CKPT_OK, CKPT_ERROR_FILE, CKPT_ERROR_RAM or
+ *                CKPT_ERROR_FORMAT
+ * =====================================================================================
+ */
+    int
+readCheckpoint(char* filename, struct checkpoint* ckpt)
+{
+    memset(ckpt, 0, sizeof(struct checkpoint));
+    FILE* in = fopen(filename, "rb");
+    if (!in)
+    {
+        return CKPT_ERROR_FILE;
+    }
+    struct ckpt_header header;
+    if ( (fread(&header, sizeof(struct ckpt_header), 1, in) != 1) ||
+         memcmp(header.magic, CKPT_MAGIC, sizeof(CKPT_MAGIC)) ||
+         (header.version != CKPT_VERSION) || (header.max_card < 1) ||
+         (header.max_card > UINT16_MAX) || (header.rx_count > INT_MAX) ||
+         (header.red_rx_count > header.rx_count) ||
+         (header.row_count >= UINT32_MAX) )
+    {
+        fclose(in);
+        return CKPT_ERROR_FORMAT;
+    }
+    ckpt->hash         = header.hash;
+    ckpt->rx_count     = header.rx_count;
+    ckpt->red_rx_count = header.red_rx_count;
+    ckpt->max_card     = header.max_card;
+    ckpt->row_count    = header.row_count;
+    ckpt->row_cards    = malloc((ckpt->row_count + 1) * sizeof(uint16_t));
+    ckpt->cutsets      = malloc((ckpt->row_count * ckpt->max_card + 1) *
+            sizeof(uint128));
+    if ( (NULL == ckpt->row_cards) || (NULL == ckpt->cutsets) )
+    {
+        fclose(in);
+        freeCheckpoint(ckpt);
+        return CKPT_ERROR_RAM;
+    }
+    int ok = fread(ckpt->row_cards, sizeof(uint16_t), ckpt->row_count, in) ==
+        ckpt->row_count;
+    ok = ok && fread(ckpt->cutsets, sizeof(uint128), ckpt->row_count *
+            ckpt->max_card, in) == ckpt->row_count * ckpt->max_card;
+    unsigned long li;
+    for (li = 0; ok && (li < ckpt->row_count); li++)
+    {
+        ok = ckpt->row_cards[li] <= ckpt->max_card;
+    }
+    fclose(in);
+    if (!ok)
+    {
+        freeCheckpoint(ckpt);
+        return CKPT_ERROR_FORMAT;
+    }
+    return CKPT_OK;
+}		/* -----  end of function readCheckpoint  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeCheckpoint
+ *  Description:  frees memory of a checkpoint read by readCheckpoint
+ * =====================================================================================
+ */
+    void
+freeCheckpoint(struct checkpoint* ckpt)
+{
+    free(ckpt->row_cards);
+    free(ckpt->cutsets);
+    ckpt->row_cards = NULL;
+    ckpt->cutsets   = NULL;
+}		/* -----  end of function freeCheckpoint  ----- */
@@ -51,68 +51,274 @@
 // SUCH DAMAGES.
 ///////////////////////////////////////////////////////////////////////////////
 
-unsigned long choose(int n, int k);
+#include <math.h>
+
+typedef unsigned __int128 uint128;
+
+#define UINT128_MAX_VALUE (~(uint128)0)
+
+// precomputed binomials C(n,k) for 0 <= n <= binomMaxN and 0 <= k <= binomMaxK
+// exact values saturate at UINT128_MAX_VALUE
+static int      binomMaxN      = -1;
+static int      binomMaxK      = -1;
+static uint128* binomTable     = NULL;
+static double*  logBinomTable  = NULL;
+static double*  logFactTable   = NULL;
+
+int initBinomTable(int max_n, int max_k);
+void freeBinomTable(void);
+uint128 chooseExact(int n, int k);
 double binom(int n, int k);
+double logBinom(int n, int k);
+double logFactorial(int n);
+void sprintUint128(char* str, uint128 value);
+uint128 parseUint128(char* str);
 unsigned long getHcf(unsigned long a, unsigned long b);
 int min(int a, int b);
 
 /* 
  * ===  FUNCTION  ======================================================================
- *         Name:  choose
- *  Description:  returns binomial of n over k
+ *         Name:  initBinomTable
+ *  Description:  precomputes exact and logarithmic binomials of n over k for
+ *                n <= max_n and k <= max_k
+ *                needs to be called once before the first threads start
+ *                returns 0 if there is not enough free memory
  * =====================================================================================
  */
-    unsigned long 
-choose(int n, int k)
+    int
+initBinomTable(int max_n, int max_k)
 {
-    unsigned long num = 1;
-    unsigned long den = 1;
+    freeBinomTable();
+    if (max_k > max_n)
+    {
+        max_k = max_n;
+    }
+    size_t row   = max_k + 1;
+    binomTable    = malloc((max_n + 1) * row * sizeof(uint128));
+    logBinomTable = malloc((max_n + 1) * row * sizeof(double));
+    logFactTable  = malloc((max_n + 1) * sizeof(double));
+    if ( (NULL == binomTable) || (NULL == logBinomTable) || 
+         (NULL == logFactTable) )
+    {
+        freeBinomTable();
+        return 0;
+    }
+
+    // log(n!) as sum of logarithms
+    int n, k;
+    logFactTable[0] = 0;
+    for (n = 1; n <= max_n; n++)
+    {
+        logFactTable[n] = logFactTable[n-1] + log(n);
+    }
+
+    // Pascal's triangle
+    for (n = 0; n <= max_n; n++)
+    {
+        uint128* c  = binomTable + n * row;
+        uint128* cp = (n > 0) ? binomTable + (n - 1) * row : NULL;
+        double*  l  = logBinomTable + n * row;
+        for (k = 0; k <= max_k; k++)
+        {
+            if (k == 0)
+            {
+                c[k] = 1;
+            }
+            else if (k > n)
+            {
+                c[k] = 0;
+            }
+            else if ( (cp[k-1] == UINT128_MAX_VALUE) || 
+                      (cp[k] == UINT128_MAX_VALUE) || 
+                      (cp[k-1] > UINT128_MAX_VALUE - cp[k]) )
+            {
+                c[k] = UINT128_MAX_VALUE;
+            }
+            else
+            {
+                c[k] = cp[k-1] + cp[k];
+            }
+            if (k > n)
+            {
+                l[k] = -INFINITY;
+            }
+            else
+            {
+                l[k] = logFactTable[n] - logFactTable[k] - logFactTable[n-k];
+            }
+        }
+    }
+    binomMaxN = max_n;
+    binomMaxK = max_k;
+    return 1;
+}		/* -----  end of function initBinomTable  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeBinomTable
+ *  Description:  frees memory of the binomial table
+ * =====================================================================================
+ */
+    void
+freeBinomTable(void)
+{
+    free(binomTable);
+    free(logBinomTable);
+    free(logFactTable);
+    binomTable    = NULL;
+    logBinomTable = NULL;
+    logFactTable  = NULL;
+    binomMaxN     = -1;
+    binomMaxK     = -1;
+}		/* -----  end of function freeBinomTable  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  chooseExact
+ *  Description:  returns binomial of n over k as exact 128 bit integer
+ *                saturates at UINT128_MAX_VALUE
+ * =====================================================================================
+ */
+    uint128
+chooseExact(int n, int k)
+{
+    if ( (k < 0) || (k > n) )
+    {
+        return 0;
+    }
+    if ( (n <= binomMaxN) && (k <= binomMaxK) )
+    {
+        return binomTable[n * (binomMaxK + 1) + k];
+    }
+
+    // not in table: multiply and divide, each step is an exact binomial
+    if (k > n - k)
+    {
+        k = n - k;
+    }
+    uint128 c = 1;
     int i;
-    for(i = 0; i < k; i++)
+    for (i = 1; i <= k; i++)
     {
-        num *= (n-i);
-        den *= (i+1);
-        unsigned long div = getHcf(num, den);
-        if (div > 0)
+        uint128 f = n - k + i;
+        // c * f is divisible by i, divide before multiplying
+        unsigned long g = getHcf(i, (unsigned long)(c % i));
+        uint128 a = c / g;
+        uint128 b = f / (i / g);
+        if (a > UINT128_MAX_VALUE / b)
         {
-            num /= div;
-            den /= div;
+            return UINT128_MAX_VALUE;
         }
+        c = a * b;
     }
-    unsigned long sum = num/den;
-    return sum;
-}		/* -----  end of function choose  ----- */
+    return c;
+}		/* -----  end of function chooseExact  ----- */
 
 /* 
 * ===  FUNCTION  ======================================================================
 *         Name:  binom
 *  Description:  returns binomial of n over k
-*                alternative method to choose
+*                exact if n over k is in the table, from log factorials else
 * =====================================================================================
 */
     double 
 binom(int n, int k)
 {
-    if (k < 0)
+    if ( (k < 0) || (k > n) )
     {
         return 0;
     }
-    double* C = (double*)calloc(k+1, sizeof(double));
-    int i, j;
-    double res;
-    C[0] = 1;
-    for(i = 1; i <= n; i++)
+    if ( (n <= binomMaxN) && (k <= binomMaxK) )
     {
-        for(j = min(i, k); j > 0; j--)
+        uint128 c = binomTable[n * (binomMaxK + 1) + k];
+        if (c < UINT128_MAX_VALUE)
         {
-            C[j] += C[j-1];
+            return (double) c;
         }
     }
-    res = C[k];  // Store the result before freeing memory
-    free(C);  // free dynamically allocated memory to avoid memory leak
-    return res;
+    return exp(logBinom(n, k));
 }       /* -----  end of function binom  ----- */
 
+/* 
+* ===  FUNCTION  ======================================================================
+*         Name:  logBinom
+*  Description:  returns natural logarithm of binomial of n over k
+* =====================================================================================
+*/
+    double 
+logBinom(int n, int k)
+{
+    if ( (k < 0) || (k > n) )
+    {
+        return -INFINITY;
+    }
+    if ( (n <= binomMaxN) && (k <= binomMaxK) )
+    {
+        return logBinomTable[n * (binomMaxK + 1) + k];
+    }
+    return logFactorial(n) - logFactorial(k) - logFactorial(n - k);
+}       /* -----  end of function logBinom  ----- */
+
+/* 
+* ===  FUNCTION  ======================================================================
+*         Name:  logFactorial
+*  Description:  returns natural logarithm of n!
+* =====================================================================================
+*/
+    double 
+logFactorial(int n)
+{
+    if (n <= binomMaxN)
+    {
+        return logFactTable[n];
+    }
+    return lgamma(n + 1.0);
+}       /* -----  end of function logFactorial  ----- */
+
+/* 
+* ===  FUNCTION  ======================================================================
+*         Name:  sprintUint128
+*  Description:  writes decimal representation of value to str
+*                str needs space for 40 chars
+* =====================================================================================
+*/
+    void 
+sprintUint128(char* str, uint128 value)
+{
+    char digits[40];
+    int  len = 0;
+    do
+    {
+        digits[len] = '0' + (char)(value % 10);
+        value /= 10;
+        len++;
+    } while (value > 0);
+    int i;
+    for (i = 0; i < len; i++)
+    {
+        str[i] = digits[len - 1 - i];
+    }
+    str[len] = '\0';
+}       /* -----  end of function sprintUint128  ----- */
+
+/* 
+* ===  FUNCTION  ======================================================================
+*         Name:  parseUint128
+*  Description:  returns value of the leading decimal digits of str
+* =====================================================================================
+*/
+    uint128 
+parseUint128(char* str)
+{
+    uint128 value = 0;
+    while (*str >= '0' && *str <= '9')
+    {
+        value = value * 10 + (uint128)(*str - '0');
+        str++;
+    }
+    return value;
+}       /* -----  end of function parseUint128  ----- */
+
 /* 
  * ===  FUNCTION  ======================================================================
  *         Name:  getHcf
@@ -122,16 +328,13 @@ binom(int n, int k)
     unsigned long
 getHcf(unsigned long a, unsigned long b)
 {
-    unsigned long min = ( a > b ) ? b : a;
-    unsigned long i;
-    for (i = min; i >= 1; i--)
+    while (b != 0)
     {
-        if ( a%i == 0 && b%i == 0 )
-        {
-            return i;
-        }
+        unsigned long t = a % b;
+        a = b;
+        b = t;
     }
-    return 0;
+    return a;
 }		/* -----  end of function getHcf  ----- */
 
 /* 
@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// connected components of the reactions of a reduced mcs matrix
+// reactions are connected if they are part of one mcs, mcs of different
+// components share no reaction
+// component ids start with 0 in the order of the first reaction of each
+// component, reactions of no mcs have component -1
+struct mcs_components
+{
+    int            component_count;
+    int            free_rx_count;
+    int*           rx_component;
+    int*           rx_local;
+    int*           rx_counts;
+    unsigned long* mcs_counts;
+};
+
+int initMcsComponents(struct mcs_components* components, bitword* mat,
+        unsigned long mcs_count, int rx_count, int word_count);
+void freeMcsComponents(struct mcs_components* components);
+int getMcsComponent(struct mcs_components* components, bitword* mcs, int
+        word_count);
+bitword* newComponentMatrix(struct mcs_components* components, int
+        component, bitword* mat, unsigned long mcs_count, int word_count);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  findComponentRoot
+ *  Description:  returns root of rx in the union-find forest parent and
+ *                halves the path to it
+ * =====================================================================================
+ */
+    int
+findComponentRoot(int* parent, int rx)
+{
+    while (parent[rx] != rx)
+    {
+        parent[rx] = parent[parent[rx]];
+        rx         = parent[rx];
+    }
+    return rx;
+}		/* -----  end of function findComponentRoot  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initMcsComponents
+ *  Description:  finds the connected components of the mcs_count rows of
+ *                the slab mat with word_count words per row
+ *                rx_local[rx] gets the position of rx among the reactions
+ *                of its component
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+initMcsComponents(struct mcs_components* components, bitword* mat, unsigned
+        long mcs_count, int rx_count, int word_count)
+{
+    int* parent = malloc((rx_count + 1) * sizeof(int));
+    int* used   = calloc(rx_count + 1, sizeof(int));
+    components->component_count = 0;
+    components->free_rx_count   = 0;
+    components->rx_component    = malloc((rx_count + 1) * sizeof(int));
+    components->rx_local        = malloc((rx_count + 1) * sizeof(int));
+    components->rx_counts       = NULL;
+    components->mcs_counts      = NULL;
+    if ( (NULL == parent) || (NULL == used) || (NULL ==
+                components->rx_component) || (NULL == components->rx_local) )
+    {
+        free(parent);
+        free(used);
+        freeMcsComponents(components);
+        return 0;
+    }
+
+    // join all reactions of each mcs with its first reaction
+    int rx;
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        parent[rx] = rx;
+    }
+    unsigned long li;
+    int           w;
+    for (li = 0; li < mcs_count; li++)
+    {
+        bitword* row   = SLABROW(mat, li, word_count);
+        int      first = -1;
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                rx       = w * WORDBITS + __builtin_ctzll(bits);
+                used[rx] = 1;
+                if (first < 0)
+                {
+                    first = findComponentRoot(parent, rx);
+                }
+                else
+                {
+                    int root = findComponentRoot(parent, rx);
+                    if (root != first)
+                    {
+                        // the lower reaction stays root
+                        if (root < first)
+                        {
+                            parent[first] = root;
+                            first         = root;
+                        }
+                        else
+                        {
+                            parent[root] = first;
+                        }
+                    }
+                }
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // number components by their first reaction
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        components->rx_component[rx] = -1;
+        if (!used[rx])
+        {
+            components->free_rx_count++;
+            continue;
+        }
+        int root = findComponentRoot(parent, rx);
+        if (root == rx)
+        {
+            components->rx_component[rx] = components->component_count++;
+        }
+        else
+        {
+            components->rx_component[rx] = components->rx_component[root];
+        }
+    }
+    free(parent);
+    free(used);
+
+    components->rx_counts  = calloc(components->component_count + 1,
+            sizeof(int));
+    components->mcs_counts = calloc(components->component_count + 1,
+            sizeof(unsigned long));
+    if ( (NULL == components->rx_counts) || (NULL == components->mcs_counts) )
+    {
+        freeMcsComponents(components);
+        return 0;
+    }
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        int component = components->rx_component[rx];
+        if (component >= 0)
+        {
+            components->rx_local[rx] = components->rx_counts[component]++;
+        }
+    }
+    for (li = 0; li < mcs_count; li++)
+    {
+        int component = getMcsComponent(components, SLABROW(mat, li,
+                    word_count), word_count);
+        components->mcs_counts[component]++;
+    }
+    return 1;
+}		/* -----  end of function initMcsComponents  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeMcsComponents
+ *  Description:  frees the arrays of components
+ * =====================================================================================
+ */
+    void
+freeMcsComponents(struct mcs_components* components)
+{
+    free(components->rx_component);
+    free(components->rx_local);
+    free(components->rx_counts);
+    free(components->mcs_counts);
+    components->rx_component = NULL;
+    components->rx_local     = NULL;
+    components->rx_counts    = NULL;
+    components->mcs_counts   = NULL;
+}		/* -----  end of function freeMcsComponents  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getMcsComponent
+ *  Description:  returns component of mcs, the component of its first
+ *                reaction
+ * =====================================================================================
+ */
+    int
+getMcsComponent(struct mcs_components* components, bitword* mcs, int
+        word_count)
+{
+    int w;
+    for (w = 0; w < word_count; w++)
+    {
+        if (mcs[w])
+        {
+            return components->rx_component[w * WORDBITS +
+                __builtin_ctzll(mcs[w])];
+        }
+    }
+    return -1;
+}		/* -----  end of function getMcsComponent  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  newComponentMatrix
+ *  Description:  returns slab of the mcs of component with the reactions of
+ *                the component as columns, the mcs keep their order
+ *                the slab has getWordCount(rx_counts[component]) words per
+ *                row and has to be freed by free()
+ *                returns NULL if there is not enough free memory
+ * =====================================================================================
+ */
+    bitword*
+newComponentMatrix(struct mcs_components* components, int component,
+        bitword* mat, unsigned long mcs_count, int word_count)
+{
+    int      sub_word_count = getWordCount(components->rx_counts[component]);
+    bitword* sub_mat        = newBitsetSlab(components->mcs_counts[component],
+            sub_word_count);
+    if (NULL == sub_mat)
+    {
+        return NULL;
+    }
+    unsigned long row_count = 0;
+    unsigned long li;
+    int           w;
+    for (li = 0; li < mcs_count; li++)
+    {
+        bitword* row = SLABROW(mat, li, word_count);
+        if (getMcsComponent(components, row, word_count) != component)
+        {
+            continue;
+        }
+        bitword* sub_row = SLABROW(sub_mat, row_count, sub_word_count);
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                WORDSET(sub_row, components->rx_local[w * WORDBITS +
+                        __builtin_ctzll(bits)]);
+                bits &= bits - 1;
+            }
+        }
+        row_count++;
+    }
+    return sub_mat;
+}		/* -----  end of function newComponentMatrix  ----- */
@@ -59,11 +59,22 @@
 
 #include "generalFunctions.c"
 #include "combinatorics.c"
-#include "bitmakros.h"
+#include "bitsetMethods.c"
+#include "trieMethods.c"
+#include "mcsMethods.c"
+#include "taskMethods.c"
+#include "arenaMethods.c"
+#include "indexMethods.c"
+#include "checkpointMethods.c"
+#include "shardMethods.c"
 #include "pfMethods.c"
+#include "progressMethods.c"
+#include "statsMethods.c"
+#include "zddMethods.c"
+#include "componentMethods.c"
+#include "sampleMethods.c"
 
-#define BITSIZE        CHAR_BIT
-#define MAX_ARGS       5
+#define MAX_ARGS       20
 #define ERROR_ARGS     1
 #define ERROR_THREADS  2
 #define ERROR_ZERO_NR  3
@@ -71,45 +82,72 @@
 #define ERROR_RAM      5
 #define ERROR_INPUT    6
 #define ERROR_ALG      7
-#define PROGRESS_STEPS 80
+#define SPAWN_MIN_LEFT 3
+#define INDEX_COST     4
+#define CKPT_INTERVAL  300
+#define ZDD_DEFAULT_MB 1024
 
-static unsigned long progressIndex      = 0;
-static unsigned long progressCardLength = 0;
-static int           progressLocked     = 0;
-static int           actProgressChars   = 0;
-static unsigned long steps[PROGRESS_STEPS];
-static time_t        starttime; 
+// combined mcs on the frame stack of searchCutsets
+struct search_frame
+{
+    int               comb_card;
+    bitword*          comb_active;
+    bitword*          comb_stored;
+    uint128*          comb_cutsets;
+    uint32_t*         still_tocheck;
+    unsigned long     still_tocheck_count;
+    unsigned long     next;
+    struct arena_mark mark;
+};
 
 // structure needed for multithreading
 struct thread_args
 {
-    int             max_threads;
-    int             thread_id;
-    int             card;
-    int             bitlength;
-    int             max_card;
-    int             red_rx_count;
-    char**          reduced_matrix;
-    unsigned long*  start_indices;
-    unsigned long*  mcs_card_sum;
-    unsigned long** cutsets;
+    int                  thread_id;
+    int                  word_count;
+    int                  max_card;
+    int                  red_rx_count;
+    int*                 column_weights;
+    bitword*             reduced_matrix;
+    struct mcs_index*    rx_index;
+    struct set_trie*     subset_trie;
+    struct task_pool*    pool;
+    struct cutset_task*  task;
+    uint16_t*            row_cards;
+    unsigned long*       root_pending;
+    struct progress*     progress;
+    struct search_stats* stats;
+    struct search_stats* card_stats;
+    bitword*             empty_stored;
+    struct search_frame* frames;
+    int                  frame_count;
+    size_t               arena_size;
+    size_t               arena_peak;
+    struct arena         arena;
 };
 
-void printHeader(FILE *file_out, int line_length, double lambda)
+void printHeader(FILE *file_out, int line_length, double lambda, int sampled)
 {
+    // sampled tables bound P(f) by two more columns
+    char bounds[32] = "";
+    if (sampled)
+    {
+        sprintf(bounds, "     %10s     %10s", "P(f) low", "P(f) high");
+    }
+
     // print output header to stdout
     printLine('=', line_length);
-    printf("%4s     %3s    %20s     %10s     %25s     %25s\n", "n", "d",
+    printf("%4s     %3s    %20s     %10s     %25s     %25s%s\n", "n", "d",
             "weighted P(f)", "P(f)", "total cutsets(d)", 
-            "possible cutsets(d)");
+            "possible cutsets(d)", bounds);
     printf("%19slambda = %1.2e\n"," ", lambda);
     printLine('-', line_length);
 
     // print output header to output file
     fprintLine(file_out, '=', line_length);
-    fprintf(file_out, "%4s     %3s    %20s     %10s     %25s     %25s\n", "n",
+    fprintf(file_out, "%4s     %3s    %20s     %10s     %25s     %25s%s\n", "n",
             "d", "weighted P(f)", "P(f)", "total cutsets(d)", 
-            "possible cutsets(d)");
+            "possible cutsets(d)", bounds);
     fprintf(file_out, "%19slambda = %1.2e\n"," ", lambda);
     fprintLine(file_out, '-', line_length);
     fflush(file_out);
@@ -131,663 +169,1097 @@ void printFooter(FILE *file_out, int line_length, double total_weight_pF, double
     fflush(file_out);
 }
 
+/**
+ * print number of samples and cutsets of each sampled number of deletions
+ * and the bounds of total P(f) given by the confidence intervals
+ */
+void printSamples(FILE *file_out, struct sample_result* samples, int
+        exact_card, int sample_card, double lambda, double total_weight_pF)
+{
+    double total_low  = total_weight_pF;
+    double total_high = total_weight_pF;
+    int    card;
+    printf("%3s     %15s     %15s\n", "d", "samples", "sampled cutsets");
+    fprintf(file_out, "%3s     %15s     %15s\n", "d", "samples",
+            "sampled cutsets");
+    for (card = exact_card; card < sample_card; card++)
+    {
+        struct sample_result* sample = &samples[card - exact_card];
+        double                weight = getWeight(lambda, card + 1);
+        total_low  -= weight * (sample->fraction - sample->low);
+        total_high += weight * (sample->high - sample->fraction);
+        printf("%3d     %15lu     %15lu\n", card + 1, sample->samples,
+                sample->hits);
+        fprintf(file_out, "%3d     %15lu     %15lu\n", card + 1,
+                sample->samples, sample->hits);
+    }
+    printf("total P(f) low          %3.10lf\n", total_low);
+    printf("total P(f) high         %3.10lf\n", total_high);
+    fprintf(file_out, "total P(f) low          %3.10lf\n", total_low);
+    fprintf(file_out, "total P(f) high         %3.10lf\n", total_high);
+    fflush(file_out);
+}
+
 /**
  * return 1 if mcs and stored cutset overlaps at least 1 time
  */
-int contradictNotAllowedReactions(char* mcs, char* stored, int rx_count)
+int contradictNotAllowedReactions(bitword* mcs, bitword* stored, int word_count)
 {
-    int i = 0;
-    for (i = 0; i < rx_count; i++)
+    // single word rows do not pay for the kernel call
+    if (word_count == 1)
     {
-        if (BITTEST(stored, i) && BITTEST(mcs, i))
-        {
-            return 1;
-        }
+        return (mcs[0] & stored[0]) != 0;
     }
-    return 0;
+    return bitsetIntersectsKernel(mcs, stored, word_count);
 }
 
 /**
  * count set bits of mcs that are not set on active mcs
  */
-int getNotActiveReactionCount(char *mcs, char* active, int rx_count)
+int getNotActiveReactionCount(bitword* mcs, bitword* active, int word_count)
 {
+    return bitsetCountAndNotKernel(mcs, active, word_count);
+}
+
+/**
+ * count reactions of active, a column of a compressed matrix stands for
+ * column_weights[column] reactions
+ */
+int getReactionCount(bitword* active, int* column_weights, int word_count)
+{
+    if (NULL == column_weights)
+    {
+        return bitsetCount(active, word_count);
+    }
     int count = 0;
-    int i     = 0;
-    for (i = 0; i < rx_count; i++)
+    int w;
+    for (w = 0; w < word_count; w++)
     {
-        if (BITTEST(mcs, i) && !BITTEST(active,i))
+        bitword bits = active[w];
+        while (bits)
         {
-            count++;
+            count += column_weights[w * WORDBITS + __builtin_ctzll(bits)];
+            bits &= bits - 1;
         }
     }
     return count;
 }
 
 /**
- * calculates needed number of chars for bit support of mcs
+ * returns 1 if a mcs before mcs_index is a subset of active
+ * the reactions of active are listed in the arena of the worker
  */
-int getBitsize(int rx_count)
+int hasSubsetMcs(struct thread_args* worker, bitword* active, int
+        active_count, unsigned long mcs_index, int word_count)
 {
-    int rx_size = rx_count / BITSIZE;
-    int modulo  = rx_count % BITSIZE;
-    if (modulo > 0)
+    if (NULL == worker->subset_trie)
+    {
+        return 0;
+    }
+    struct arena_mark mark = arenaMark(&worker->arena);
+    int* set = arenaAlloc(&worker->arena, active_count * sizeof(int));
+    if (NULL == set)
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+    int set_count = 0;
+    int w;
+    for (w = 0; w < word_count; w++)
     {
-        rx_size++;
+        bitword bits = active[w];
+        while (bits)
+        {
+            set[set_count++] = w * WORDBITS + __builtin_ctzll(bits);
+            bits &= bits - 1;
+        }
     }
-    int bitsize = rx_size * BITSIZE;
-    return bitsize;
+    int found = trieHasSubset(worker->subset_trie, set, set_count, mcs_index);
+    arenaRelease(&worker->arena, mark);
+    return found;
 }
 
 /**
- * reads first line of MCS file to check if the file is in correct format
+ * marks all mcs before mcs_index that contain stored reactions in skip if
+ * the inverted index is cheaper than checking each of these mcs
+ * returns 0 if the mcs should be checked one by one
+ *   - every entry of a posting list costs about INDEX_COST words of a row
+ *     check and the rows of marked mcs are not read
  */
-int isValidInputFile(char *filename)
+int skipStoredByIndex(struct mcs_index* index, unsigned long mcs_index,
+        bitword* stored, int word_count, bitword* skip)
 {
-    int    valid = 0;
-    size_t len   = 0;
-    char*  line  = NULL;
-    FILE*  file  = fopen(filename, "r");
-    if (!file)
+    if ( (NULL == index) || (word_count <= INDEX_COST / 2) )
     {
-        quitError("Error in opening file\n", ERROR_FILE);
+        return 0;
+    }
+    unsigned long postings = 0;
+    int w;
+    for (w = 0; w < word_count; w++)
+    {
+        bitword bits = stored[w];
+        while (bits)
+        {
+            postings += countMcsIndexBefore(index, w * WORDBITS +
+                    __builtin_ctzll(bits), mcs_index);
+            bits &= bits - 1;
+        }
+    }
+    unsigned long skipped = postings < mcs_index ? postings : mcs_index;
+    if (skipped * word_count <= postings * INDEX_COST + WORDNSLOTS(mcs_index))
+    {
+        return 0;
     }
-    if ( getline(&line, &len, file) != -1)
+    memset(skip, 0, WORDNSLOTS(mcs_index) * sizeof(bitword));
+    for (w = 0; w < word_count; w++)
     {
-        int rx_count = (int) strlen(line) - 1;
-        char allowed[] = "01\n";
-        int pos = strspn(line, allowed);
-        if (pos < 0 || pos > rx_count)
+        bitword bits = stored[w];
+        while (bits)
         {
-            valid = 1;
+            markMcsIndex(index, w * WORDBITS + __builtin_ctzll(bits),
+                    mcs_index, skip);
+            bits &= bits - 1;
         }
     }
-    free(line);
-    line = NULL;
-    fclose(file);
-    return valid;
+    return 1;
 }
 
 /**
- * read first line mcs file and returns number of reactions
+ * hands a subtree of the cutset search over to an idle thread
+ * the subtree value is added to the cutsets of the task with the given sign
+ * the root mcs of the task is complete after all its spawned tasks
  */
-int getReactionCount(char *filename)
+void spawnCutsetTask(struct thread_args* worker, unsigned long mcs_index,
+        bitword* active, bitword* stored, int word_count, int sign)
 {
-    int    rx_count = 0;
-    char*  line     = NULL;
-    size_t len      = 0;
-    FILE *file = fopen(filename, "r");
-    if (!file)
+    bitword* bits = malloc(2 * word_count * sizeof(bitword));
+    if (NULL == bits)
     {
-        quitError("Error in opening file\n", ERROR_FILE);
+        quitError("Not enough free memory\n", ERROR_RAM);
     }
-    if ( getline(&line, &len, file) != -1)
+    bitsetCopy(bits, active, word_count);
+    bitsetCopy(bits + word_count, stored, word_count);
+    struct cutset_task task;
+    task.mcs_index = mcs_index;
+    task.root      = worker->task->root;
+    task.group     = worker->task->group;
+    task.sign      = sign;
+    task.is_root   = 0;
+    task.active    = bits;
+    task.stored    = bits + word_count;
+    task.cutsets   = worker->task->cutsets;
+    __atomic_add_fetch(&worker->root_pending[task.root], 1, __ATOMIC_RELAXED);
+    if (!pushTask(worker->pool, worker->thread_id, &task))
     {
-        rx_count = (int) strlen(line) - 1;
+        quitError("Not enough free memory\n", ERROR_RAM);
     }
-    free(line);
-    line = NULL;
-    fclose(file);
-    return(rx_count);
 }
 
 /**
- * read mcs file, consisting of 0 and 1 without spaces
- * stores values in a bit matrix
- * define cardinality for each mcs
- * calculates cardinality summary over all mcs
+ * checks mcs li against the combined mcs of frame
+ *   - mcs with stored reactions are skipped
+ *   - for mcs with one reaction left this reaction is stored
+ *   - mcs with more reactions left are added to the candidates of the frame
+ *   - a single column left of a compressed matrix is stored only if it
+ *     stands for one reaction
+ * returns 0 if mcs li is a subset of the combined mcs
  */
-void readInitialMatrix(int rx_count, unsigned long* mcs_count, char***
-        m_initial_mat, int** m_mcs_card, unsigned long* mcs_card_sum, int
-        bitarray_size, char *filename)
+int checkMcs(bitword* mcs, unsigned long li, struct search_frame* frame, int
+        word_count, int* column_weights, struct search_stats* stats)
 {
-    int    alloc_size  = 10000;
-    char** initial_mat = NULL;
-    int*   mcs_card    = NULL;
-    char*  line        = NULL;
-    int i;
-    for (i = 0; i < rx_count; i++){
-        mcs_card_sum[i] = 0;
+    if (contradictNotAllowedReactions(mcs, frame->comb_stored, word_count))
+    {
+        STAT_ADD(stats, contradicting, 1);
+        return 1;
     }
-    size_t        len      = 0;
-    unsigned long mat_ix   = 0;
-    unsigned long new_size = 0;
-    FILE *file = fopen(filename, "r");
-    if (!file)
+    int left_rx = getNotActiveReactionCount(mcs, frame->comb_active,
+            word_count);
+    int j       = -1;
+    if ( (left_rx == 1) && column_weights )
     {
-        quitError("Error in opening file\n", ERROR_FILE);
+        j       = bitsetFirstAndNot(mcs, frame->comb_active, word_count);
+        left_rx = column_weights[j];
     }
-    
-    while ( getline(&line, &len, file) != -1)
+    if (left_rx == 1)
     {
-        // reallocate for new mcs in file
-        if (mat_ix % alloc_size == 0)
-        {
-            new_size = mat_ix + alloc_size;
-            initial_mat = (char**) realloc(initial_mat, new_size *
-                    sizeof(char*));
-            mcs_card = (int*) realloc(mcs_card, new_size * sizeof(int));
-            if ( (NULL == initial_mat) || (NULL == mcs_card) )
-            {
-                quitError("Not enough free memory in readInitialMatrix\n", ERROR_RAM);
-            }
-        }
-
-        // allocate for actual mcs
-        initial_mat[mat_ix] = calloc(1, bitarray_size);
-        if (NULL == initial_mat[mat_ix])
+        if (j < 0)
         {
-            quitError("Not enough free memory\n", ERROR_RAM);
-        }
-
-        // store mcs in matrix and define cardinality
-        int card = 0;
-        for (i = 0; i < rx_count; i++)
-        {
-            if (line[i] == '1')
-            {
-                BITSET(initial_mat[mat_ix], i);
-                card++;
-            } 
+            j = bitsetFirstAndNot(mcs, frame->comb_active, word_count);
         }
-        mcs_card[mat_ix] = card - 1;
-        mcs_card_sum[card-1]++;
-        mat_ix++;
+        WORDSET(frame->comb_stored, j);
+        STAT_ADD(stats, stored, 1);
     }
-
-    // set return pointer
-    *mcs_count     = mat_ix;
-    *m_initial_mat = (char**) realloc(initial_mat, mat_ix * sizeof(char*));
-    *m_mcs_card    = (int*) realloc(mcs_card, mat_ix * sizeof(int));
-    if ( (NULL == *m_initial_mat) || (NULL == *m_mcs_card) )
+    else if (left_rx > 1)
     {
-        quitError("Not enough free memory\n", ERROR_RAM);
+        frame->still_tocheck[frame->still_tocheck_count] = li;
+        frame->still_tocheck_count++;
+        STAT_ADD(stats, candidates, 1);
     }
-    free(line);
-    line = NULL;
-    fclose(file);
+    else
+    {
+        // is a subset
+        return 0;
+    }
+    return 1;
 }
 
 /**
- * remove single knockouts from matrix
- *   - remove rows with single knockouts
- *   - remove columns where single knockouts == 1
- * remove knockouts from matrix with higher cardinality than max_card
+ * prepares the frame of the combined mcs of mcs_index and active
+ *   - candidates are the only mcs before mcs_index that can be part of the
+ *     combination, if NULL all mcs before mcs_index are checked
+ *   - the candidates of the frame are allocated on the arena of the worker
+ * returns 0 if the combined mcs does not add cutsets
  */
-void processMatrix(int rx_count, unsigned long mcs_count, char** initial_mat,
-        int* mcs_card, unsigned long* mcs_card_sum, int bitarray_size, int
-        red_rx_count, unsigned long red_mcs_count, char** red_mat, int
-        red_bitarray_size, int max_card)
+int enterSearchFrame(struct thread_args* worker, struct search_frame* frame,
+        unsigned long mcs_index, bitword* active, bitword* stored, uint32_t*
+        candidates, unsigned long candidate_count)
 {
-    // allocate memory for columnts of reduced matrix
-    int* left_cols = calloc(red_rx_count, sizeof(int));
+    struct arena* arena          = &worker->arena;
+    bitword*      reduced_matrix = worker->reduced_matrix;
+    int           word_count     = worker->word_count;
+    int           max_card       = worker->max_card;
+
+    // actualize active reactions
+    frame->mark = arenaMark(arena);
+    bitsetOr(frame->comb_active, SLABROW(reduced_matrix, mcs_index,
+                word_count), active, word_count);
+    frame->comb_card = getReactionCount(frame->comb_active,
+            worker->column_weights, word_count) - 1;
+
+    // combined mcs beyond max_card or covering a mcs checked before do not
+    // add any cutsets
+    if (frame->comb_card >= max_card)
+    {
+        STAT_ADD(worker->card_stats, rejected_card, 1);
+        arenaRelease(arena, frame->mark);
+        return 0;
+    }
+    if (hasSubsetMcs(worker, frame->comb_active, frame->comb_card + 1,
+                mcs_index, word_count))
+    {
+        STAT_ADD(worker->card_stats, subsets, 1);
+        arenaRelease(arena, frame->mark);
+        return 0;
+    }
 
-    // remove single knockouts
-    if (mcs_card_sum[0] > 0)
+    // copy stored reactions and define left candidates
+    bitsetCopy(frame->comb_stored, stored, word_count);
+    frame->still_tocheck_count = 0;
+    frame->still_tocheck       = arenaAlloc(arena, (candidates ?
+                candidate_count : mcs_index) * sizeof(uint32_t));
+    if (NULL == frame->still_tocheck)
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+    int found_subset = 0;
+    unsigned long li;
+    if (candidates)
     {
-        // define bitset for single knockouts
-        char* single_ko_cols = calloc(1, bitarray_size);
-        if (NULL == single_ko_cols)
+        unsigned long ci;
+        for (ci = 0; (ci < candidate_count) && !found_subset; ci++)
         {
-            quitError("Not enough free memory\n", ERROR_RAM);
+            li = candidates[ci];
+            found_subset = !checkMcs(SLABROW(reduced_matrix, li, word_count),
+                    li, frame, word_count, worker->column_weights,
+                    worker->card_stats);
         }
-
-        // find reactions of single knockouts
-        unsigned long li = 0;
-        for (li = 0; li < mcs_count; li++)
+    }
+    else
+    {
+        // mcs containing stored reactions may be skipped by the inverted
+        // index, reactions stored during the search are checked row by row
+        struct arena_mark skip_mark = arenaMark(arena);
+        bitword* skip = arenaAlloc(arena, WORDNSLOTS(mcs_index) *
+                sizeof(bitword));
+        if (NULL == skip)
         {
-            if (mcs_card[li] == 0)
-            {
-                int j = 0;
-                for (j = 0; j < rx_count; j++)
-                {
-                    if (BITTEST(initial_mat[li],j))
-                    {
-                        BITSET(single_ko_cols, j);
-                        j = rx_count;
-                    }
-                }
-            }
+            quitError("Not enough free memory\n", ERROR_RAM);
         }
-
-        // define columns that are not used by single knockouts
-        int i = 0;
-        int j = 0;
-        for (i = 0; i < rx_count; i++){
-            if (!(BITTEST(single_ko_cols, i))){
-                left_cols[j] = i;
-                j++;
-            }
+        if (!skipStoredByIndex(worker->rx_index, mcs_index, stored,
+                    word_count, skip))
+        {
+            skip = NULL;
         }
-        free(single_ko_cols);
-        single_ko_cols = NULL;
-    } 
-    else 
-    {
-        // no single knockout, set left columns to all columns
-        int i = 0;
-        for (i = 0; i < red_rx_count; i++)
+        for (li = skip ? bitsetNextClear(skip, 0, mcs_index) : 0;
+                (li < mcs_index) && !found_subset;
+                li = skip ? bitsetNextClear(skip, li + 1, mcs_index) : li + 1)
         {
-            left_cols[i] = i;
+            found_subset = !checkMcs(SLABROW(reduced_matrix, li, word_count),
+                    li, frame, word_count, worker->column_weights,
+                    worker->card_stats);
         }
+        arenaRelease(arena, skip_mark);
+    }
+    if (found_subset)
+    {
+        STAT_ADD(worker->card_stats, subsets, 1);
+        arenaRelease(arena, frame->mark);
+        return 0;
     }
 
-    // reduce matrix
-    int           i  = 0;
-    unsigned long li = 0;
-    for (i = 1; i < max_card; i++)
+    // define degree of freedom for combined mcs
+    // stored and active reactions are disjoint
+    int dof = worker->red_rx_count - frame->comb_card - 1 - bitsetCount(
+            frame->comb_stored, word_count);
+    int i;
+    for (i = frame->comb_card; i < max_card; i++)
     {
-        // if exist mcs with cardinality i
-        if (mcs_card_sum[i] > 0)
-        {
-            // compare with all mcs and sort mcs by cardinality
-            unsigned long mcs_ix = 0;
-            for (mcs_ix = 0; mcs_ix < mcs_count; mcs_ix++)
-            {
-                // add all mcs with cardinality i to matrix
-                if (mcs_card[mcs_ix] == i)
-                {
-                    red_mat[li] = calloc(1, red_bitarray_size);
-                    int k = 0;
-                    for (k = 0; k < red_rx_count; k++)
-                    {
-                        if (BITTEST(initial_mat[mcs_ix],left_cols[k]))
-                        {
-                            BITSET(red_mat[li],k);
-                        }
-                    }
-                    li++;
-                }
-            }
-        }
+        frame->comb_cutsets[i] = chooseExact(dof, i - frame->comb_card);
+    }
+    STAT_ADD(worker->card_stats, chooses, max_card - frame->comb_card);
+    STAT_ADD(worker->card_stats, nodes, 1);
+
+    // candidates are only combined if larger cardinalities are left
+    if ( ((frame->comb_card + 1) >= max_card) ||
+            (frame->comb_cutsets[frame->comb_card + 1] == 0) )
+    {
+        frame->still_tocheck_count = 0;
     }
-    free(left_cols);
-    left_cols = NULL;
+    frame->next = 0;
+    return 1;
 }
 
 /*
  * main part of the algorithm
  * searches cutsets out of mcs without considering a cutset more than once
+ *   - the value of a combined mcs is the number of its cutsets minus the
+ *     values of the combinations with its candidates
+ *   - the value of the combination of the task is added with sign to the
+ *     cutsets of the task from first_card on, combinations may be spawned as
+ *     tasks with opposite sign
+ *   - combinations are searched depth first on the preallocated frames of
+ *     the worker, the candidates of a combination are the candidates of its
+ *     parent before the added mcs that are still not contradicting
  */
-void recursiveCutsetSearch(char** reduced_matrix, unsigned long mcs_index,
-        char* active, char* stored, int red_rx_count, int bitlength, int
-        max_card, unsigned long* cutsets, int inRecursion)
+void searchCutsets(struct thread_args* worker, unsigned long mcs_index,
+        bitword* active, bitword* stored, uint128* cutsets, int sign, int
+        first_card)
 {
-    // prepare memory
-    int            comb_card = 0;
-    unsigned long  still_tocheck_count = 0;
-    unsigned long* still_tocheck_ix = calloc(mcs_index, sizeof(unsigned long));
-    unsigned long* comb_cutsets = calloc(max_card, sizeof(unsigned long));
-    char*          comb_active = calloc(1, bitlength);
-    char*          comb_stored = calloc(1, bitlength);
-    if ( (NULL == still_tocheck_ix) || (NULL == comb_active) || 
-         (NULL == comb_stored) || (NULL == comb_cutsets) )
+    struct search_frame* frames     = worker->frames;
+    bitword*             matrix     = worker->reduced_matrix;
+    int                  word_count = worker->word_count;
+    int                  max_card   = worker->max_card;
+    int                  depth      = 0;
+
+    if (!enterSearchFrame(worker, &frames[0], mcs_index, active, stored, NULL,
+                0))
     {
-        quitError("Not enough free memory\n", ERROR_RAM);
+        return;
     }
-
-    // copy stored and actualize active reactions
-    int i;
-    for (i = 0; i < red_rx_count; i++)
+    while (depth >= 0)
     {
-        if ( (BITTEST(reduced_matrix[mcs_index], i)) || (BITTEST(active, i)) )
+        struct search_frame* frame   = &frames[depth];
+        int                  entered = 0;
+        while ( (frame->next < frame->still_tocheck_count) && !entered )
         {
-            BITSET(comb_active, i);
-            comb_card++;
-        }
-        if (BITTEST(stored, i))
-        {
-            BITSET(comb_stored, i);
-        }
-    }
-    comb_card--;
+            unsigned long ci = frame->next++;
+            unsigned long li = frame->still_tocheck[ci];
 
-    // prepare cutset search
-    int found_subset = 0;
-    unsigned long li;
-    for (li = 0; li < mcs_index; li++)
-    {
-        if (!contradictNotAllowedReactions(reduced_matrix[li], comb_stored,
-                    red_rx_count))
-        {
-            int left_rx = getNotActiveReactionCount(reduced_matrix[li],
-                    comb_active, red_rx_count);
-            if (left_rx == 1)
+            // candidates have more than one reaction left, reactions stored
+            // after they were found may contradict them
+            if (contradictNotAllowedReactions(SLABROW(matrix, li,
+                            word_count), frame->comb_stored, word_count))
             {
-                int j;
-                for (j = 0; j < red_rx_count; j++)
-                {
-                    if (BITTEST(reduced_matrix[li], j) &&
-                            (!BITTEST(comb_active, j)))
-                    {
-                        BITSET(comb_stored, j);
-                        break;
-                    }
-                }
+                STAT_ADD(worker->card_stats, contradicting, 1);
+                continue;
             }
-            else if (left_rx > 1)
+            if ( (max_card - frame->comb_card > SPAWN_MIN_LEFT) &&
+                    wantsTask(worker->pool, worker->thread_id) )
             {
-                still_tocheck_ix[still_tocheck_count] = li;
-                still_tocheck_count++;
+                spawnCutsetTask(worker, li, frame->comb_active,
+                        frame->comb_stored, word_count, depth % 2 ? sign :
+                        -sign);
+                STAT_ADD(worker->card_stats, spawned, 1);
             }
             else
             {
-                // is a subset
-                found_subset = 1;
-                break;
+                if (depth + 1 >= worker->frame_count)
+                {
+                    quitError("searchCutsets: You should not end up here: \
+frame stack exceeded\n", ERROR_ALG);
+                }
+                entered = enterSearchFrame(worker, &frames[depth + 1], li,
+                        frame->comb_active, frame->comb_stored,
+                        frame->still_tocheck, ci);
             }
         }
-    }
-    if (!found_subset)
-    {
-        // define degree of freedom for combined mcs
-        int dof = 0;
+        if (entered)
+        {
+            depth++;
+            STAT_MAX(worker->card_stats, max_depth, depth);
+            continue;
+        }
+
+        // counts are exact modulo 2^128, negative intermediate values wrap
+        // around and cancel out as the final count is below 2^128
         int i;
-        for (i = 0; i < red_rx_count; i++)
+        if (depth > 0)
         {
-            if ( (!BITTEST(comb_stored,i)) && (!BITTEST(comb_active,i)) )
+            uint128* parent_cutsets = frames[depth - 1].comb_cutsets;
+            for (i = frame->comb_card; i < max_card; i++)
             {
-                dof++;
+                parent_cutsets[i] -= frame->comb_cutsets[i];
             }
         }
-        for (i = comb_card; i < max_card; i++)
-        {
-            comb_cutsets[i] = choose(dof, i - comb_card);
-        }
-        if ( (comb_card + 1) < max_card)
+        else
         {
-            if ( comb_cutsets[comb_card + 1] > 0 )
+            // other tasks may add to the same cutsets
+            pthread_mutex_t* lock = getResultLock(worker->pool, cutsets);
+            pthread_mutex_lock(lock);
+            i = frame->comb_card > first_card ? frame->comb_card : first_card;
+            for (; i < max_card; i++)
             {
-                unsigned long li;
-                for (li = 0; li < still_tocheck_count; li++)
+                if (sign > 0)
                 {
-                    if (!contradictNotAllowedReactions(
-                           reduced_matrix[still_tocheck_ix[li]], 
-                           comb_stored, red_rx_count))
-                    {
-                        int left_rx = getNotActiveReactionCount(
-                                reduced_matrix[still_tocheck_ix[li]],
-                                comb_active, red_rx_count);
-                        if (left_rx > 1)
-                        {
-                            recursiveCutsetSearch(reduced_matrix,
-                                    still_tocheck_ix[li], comb_active,
-                                    comb_stored, red_rx_count, bitlength,
-                                    max_card, comb_cutsets, 1);
-                        }
-                        else
-                        {
-                            quitError("recursiveCutsetSearch: You should not \
-end up here: left_rx <= 1\n", ERROR_ALG);
-                        }
-                    } 
+                    cutsets[i] += frame->comb_cutsets[i];
                 }
-            }
-        }
-        if (inRecursion)
-        {
-            for (i = comb_card; i < max_card; i++)
-            {
-                cutsets[i] = cutsets[i] - comb_cutsets[i];
-                if (cutsets[i] < 0)
+                else
                 {
-                    cutsets[i] = 0;
+                    cutsets[i] -= frame->comb_cutsets[i];
                 }
             }
+            pthread_mutex_unlock(lock);
         }
-        else
-        {
-            for (i = comb_card; i < max_card; i++)
-            {
-                cutsets[i] = comb_cutsets[i];
-            }
-        }
+        arenaRelease(&worker->arena, frame->mark);
+        depth--;
     }
-    // free memory
-    free(comb_cutsets);
-    free(comb_active);
-    free(comb_stored);
-    free(still_tocheck_ix);
-    comb_cutsets = NULL;
-    comb_active = NULL;
-    comb_stored = NULL;
-    still_tocheck_ix = NULL;
 }
 
 /**
- * resets variables needed to show progress of calculation
+ * multithread function to define cutsets
+ * runs tasks of the own deque and steals tasks of other threads
  */
-void resetStaticProgressVariables(unsigned long card_length)
+void *analyseMcs(void *pointer_thread_args)
 {
-    progressIndex = 0;
-    progressCardLength = card_length; 
-    unsigned long div = (unsigned long) progressCardLength/PROGRESS_STEPS;
-    steps[0] = 0;
-    int i;
-    for (i = 1; i < PROGRESS_STEPS; i++)
+    // unpack given arguments
+    struct thread_args* thread_args    = (struct thread_args*)
+        pointer_thread_args;
+    int                 thread_id      = thread_args->thread_id;
+    int                 word_count     = thread_args->word_count;
+    int                 max_card       = thread_args->max_card;
+    struct task_pool*   pool           = thread_args->pool;
+
+    // each level of the search adds at least two reactions to the combined
+    // mcs, frames beyond max_card are rejected directly
+    int    frame_count = max_card / 2 + 2;
+    size_t frame_size  = max_card * sizeof(uint128) + 2 * word_count *
+        sizeof(bitword);
+    thread_args->frame_count  = frame_count;
+    thread_args->frames       = malloc(frame_count *
+            sizeof(struct search_frame));
+    thread_args->empty_stored = calloc(word_count, sizeof(bitword));
+    char* frame_memory        = malloc(frame_count * frame_size);
+    if ( (NULL == thread_args->empty_stored) || (NULL == thread_args->frames)
+            || (NULL == frame_memory) ||
+            !initArena(&thread_args->arena, thread_args->arena_size) )
     {
-        steps[i] = i * div;
+        quitError("Not enough free memory\n", ERROR_RAM);
     }
-    starttime = time(NULL);
-    actProgressChars = 0;
-}
-
-/**
- * deletes progress bar from stdout
- */
-void clearProgress()
-{
-    int ri;
-    int add = 40;
-    for (ri = 0; ri < add; ri++)
+    int i;
+    for (i = 0; i < frame_count; i++)
     {
-        printf(" ");
+        struct search_frame* frame = &thread_args->frames[i];
+        frame->comb_cutsets = (uint128*) (frame_memory + i * frame_size);
+        frame->comb_active  = (bitword*) (frame->comb_cutsets + max_card);
+        frame->comb_stored  = frame->comb_active + word_count;
     }
-    int all = PROGRESS_STEPS + 2*add;
-    for (ri = 0; ri < all; ri++)
+
+    struct cutset_task task;
+    while (getNextTask(pool, thread_id, &task))
     {
-        printf("\b");
+        bitword* stored = task.stored;
+        if (task.is_root)
+        {
+            addProgress(thread_args->progress, thread_id);
+            stored = thread_args->empty_stored;
+        }
+        // cutsets of cardinalities below first_card were read from a
+        // checkpoint, they are complete until all tasks of the root are done
+        int first_card = __atomic_load_n(&thread_args->row_cards[task.root],
+                __ATOMIC_RELAXED);
+        thread_args->task = &task;
+#ifdef SEARCH_STATS
+        thread_args->card_stats = &thread_args->stats[task.group];
+        double cpu_start        = getThreadCpuSeconds();
+#endif
+        searchCutsets(thread_args, task.mcs_index, task.active, stored,
+                task.cutsets, task.sign, first_card);
+#ifdef SEARCH_STATS
+        thread_args->card_stats->tasks++;
+        thread_args->card_stats->cpu_seconds += getThreadCpuSeconds() -
+            cpu_start;
+#endif
+        if (!task.is_root)
+        {
+            // active and stored of spawned tasks share one allocation
+            free(task.active);
+        }
+        if (__atomic_sub_fetch(&thread_args->root_pending[task.root], 1,
+                    __ATOMIC_ACQ_REL) == 0)
+        {
+            __atomic_store_n(&thread_args->row_cards[task.root], max_card,
+                    __ATOMIC_RELEASE);
+        }
+        finishTask(pool, &task);
     }
-    fflush(stdout);
+    free(frame_memory);
+    free(thread_args->frames);
+    free(thread_args->empty_stored);
+    thread_args->frames       = NULL;
+    thread_args->empty_stored = NULL;
+    thread_args->arena_peak   = thread_args->arena.peak;
+    freeArena(&thread_args->arena);
+    return((void *)NULL);
 }
 
 /**
- * print progress bar and expected left seconds for the calculation
+ * starts analyses of all mcs in one parallel phase
+ * calls multithreaded analyseMcs
+ *   - mcs of cardinality card + 1 form task group card
+ *   - the cutsets of the mcs with the highest analysed cardinality are
+ *     not needed by getCutsets and are therefore not calculated
+ *   - only the mcs of shard of shard_count are analysed
+ *   - reduced_matrix has column_count columns, a column stands for
+ *     column_weights[column] of the red_rx_count reactions or for one
+ *     reaction if column_weights is NULL
  */
-void printProgress()
+void startAnalysis(bitword* reduced_matrix, struct mcs_index* rx_index,
+        struct set_trie* subset_trie, int red_rx_count, int column_count, int*
+        column_weights, unsigned long* start_indices, int max_threads, int
+        max_card, int shard, int shard_count, uint128* cutsets, uint16_t*
+        row_cards, unsigned long* root_pending, struct progress* progress,
+        struct search_stats* stats, struct task_pool* pool, pthread_t* thread,
+        struct thread_args* thread_args)
 {
-    progressIndex++;
-    // only update progress if it is not done by other thread
-    if (!progressLocked)
+    // define number of words per mcs
+    int word_count = getWordCount(column_count);
+
+    // define arena blocks to hold the candidates of a task and of its first
+    // combination, deeper combinations have fewer candidates
+    size_t arena_size = 2 * start_indices[max_card - 1] * sizeof(uint32_t) +
+        WORDNSLOTS(start_indices[max_card - 1]) * sizeof(bitword) +
+        max_card * sizeof(int) + 6 * ARENA_ALIGN;
+
+    // distribute mcs round robin on deques of threads
+    // threads start with the mcs of lowest cardinality of their deque
+    // mcs that are complete in a checkpoint or belong to another shard are
+    // skipped, shards are assigned in the order of decreasing costs
+    if (!initTaskPool(pool, max_threads, max_card))
     {
-        // lock progress for other threads
-        progressLocked = 1;
-
-        // define progress bar length
-        int i;
-        for (i = actProgressChars; i < PROGRESS_STEPS; i++)
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+    unsigned long first = start_indices[1];
+    unsigned long last  = start_indices[max_card - 1];
+    unsigned long roots = 0;
+    int           card  = max_card - 2;
+    unsigned long index;
+    for (index = last; index > first; index--)
+    {
+        while (start_indices[card] > index - 1)
         {
-            if (progressIndex >= steps[i])
-            {
-                actProgressChars = i;
-            }
-            else
-            {
-                i = PROGRESS_STEPS;
-            }
+            card--;
         }
-
-        // clear progress bar and print new one
-        clearProgress();
-        printf("[");
-        for (i = 0; i < actProgressChars; i++)
+        if ( (row_cards[index - 1] >= max_card) || (getShardOfMcs(last -
+                        index, shard_count) != shard) )
         {
-            printf("=");
+            continue;
         }
-        printf(">");
-        for (i = actProgressChars; i < PROGRESS_STEPS; i++)
+        root_pending[index - 1] = 1;
+        struct cutset_task task;
+        task.mcs_index = index - 1;
+        task.root      = index - 1;
+        task.group     = card;
+        task.sign      = 1;
+        task.is_root   = 1;
+        task.active    = SLABROW(reduced_matrix, index - 1, word_count);
+        task.stored    = NULL;
+        task.cutsets   = cutsets + (index - 1) * max_card;
+        if (!pushTask(pool, roots % max_threads, &task))
         {
-            printf(" ");
+            quitError("Not enough free memory\n", ERROR_RAM);
         }
-        printf("] ");
+        roots++;
+    }
 
-        // print progress percentage
-        double prg = 100 * (double)progressIndex / (double)progressCardLength;
-        if (prg < 10)
-        {
-            printf(" ");
-        }
-        printf("%.2f%%", prg);
+    // prepare threads
+    int i;
+    for (i = 0; i < max_threads; i++)
+    {
+        thread_args[i].thread_id      = i;
+        thread_args[i].word_count     = word_count;
+        thread_args[i].max_card       = max_card;
+        thread_args[i].red_rx_count   = red_rx_count;
+        thread_args[i].column_weights = column_weights;
+        thread_args[i].reduced_matrix = reduced_matrix;
+        thread_args[i].rx_index       = rx_index;
+        thread_args[i].subset_trie    = subset_trie;
+        thread_args[i].pool           = pool;
+        thread_args[i].task           = NULL;
+        thread_args[i].row_cards      = row_cards;
+        thread_args[i].root_pending   = root_pending;
+        thread_args[i].progress       = progress;
+        thread_args[i].stats          = stats ? stats + i * max_card : NULL;
+        thread_args[i].card_stats     = NULL;
+        thread_args[i].empty_stored   = NULL;
+        thread_args[i].arena_size     = arena_size;
+        thread_args[i].arena_peak     = 0;
+    }
 
-        // print expected left runtime for this step
-        time_t acttime = time(NULL);
-        if (acttime > starttime)
-        {
-            int diff = (int)acttime - (int)starttime;
-            double expected = diff * (100-prg) / prg;
-            printf(" (%d sec) ", (int)expected);
-        }
-        else 
-        {
-            printf(" (??? sec) ");
-        }
-        fflush(stdout);
+    startProgressReporter(progress, roots);
 
-        // unlock progress for other threads
-        progressLocked = 0;
+    // start threads
+    for (i = 0; i < max_threads; i++)
+    {
+        pthread_create(&thread[i], NULL, analyseMcs, 
+                (void *)&thread_args[i]);
     }
 }
 
 /**
- * multithread function to define cutsets
- * for each mcs
+ * writes a checkpoint, a failed checkpoint does not stop the analysis
  */
-void *analyseMcs(void *pointer_thread_args)
+void saveCheckpoint(char* ckpt_file, struct checkpoint* state)
 {
-    // unpack given arguments
-    struct thread_args* thread_args    = (struct thread_args*)
-        pointer_thread_args;
-    int                 thread_id      = thread_args->thread_id;
-    int                 max_threads    = thread_args->max_threads;
-    int                 bitlength      = thread_args->bitlength;
-    int                 card           = thread_args->card;
-    int                 max_card       = thread_args->max_card;
-    int                 red_rx_count   = thread_args->red_rx_count;
-    unsigned long*      start_indices  = thread_args->start_indices;
-    unsigned long*      mcs_card_sum   = thread_args->mcs_card_sum;
-    char**              reduced_matrix = thread_args->reduced_matrix;
-    unsigned long**     cutsets        = thread_args->cutsets;
-
-    // check every mcs of cardinality card
-    unsigned long index;
-    unsigned long last = start_indices[card] + mcs_card_sum[card];
-    for (index = start_indices[card]; index < last; index++)
+    if (CKPT_OK != writeCheckpoint(ckpt_file, state))
     {
-        // check if mcs is calculated by this thread
-        if ( (index % max_threads) == thread_id)
-        {
-            printProgress();
-            char* stored = calloc(1, bitlength);
-            if ( NULL == stored )
-            {
-                quitError("Not enough free memory\n", ERROR_RAM);
-            }
-            recursiveCutsetSearch(reduced_matrix, index, reduced_matrix[index],
-                    stored, red_rx_count, bitlength, max_card, cutsets[index],
-                    0);
-            free(stored);
-            stored = NULL;
-        }
+        fprintf(stderr, "Error in writing checkpoint %s\n", ckpt_file);
     }
-    return((void *)NULL);
 }
 
 /**
- * prepare analyses of each mcs with given cardinality
- * calls multithreaded analyseMcs
- *   - card = cardinality - 1!
- *       if cardinality of mcs = 2 then card = 1
+ * waits until the cutsets needed by getCutsets for card are calculated
+ *   - cardinalities that are complete in a checkpoint are not awaited
+ *   - while waiting a checkpoint is written every ckpt_interval seconds
  */
-void analyseCard(char** reduced_matrix, unsigned long red_mcs_count, int
-        red_rx_count, unsigned long* mcs_card_sum, unsigned long*
-        start_indices, int card, int max_threads, int max_card, unsigned long**
-        cutsets)
+void waitForCard(struct task_pool* pool, int card, unsigned long*
+        start_indices, char* ckpt_file, int ckpt_interval, struct
+        checkpoint* state)
 {
-    if (mcs_card_sum[card] > 0)
+    int           complete = 1;
+    unsigned long li;
+    for (li = start_indices[1]; (li < start_indices[card]) && complete; li++)
+    {
+        complete = __atomic_load_n(&state->row_cards[li], __ATOMIC_ACQUIRE) >
+            card;
+    }
+    if (complete)
+    {
+        return;
+    }
+    if (NULL == ckpt_file)
     {
-        // define bitlength
-        int bitlength = getBitsize(red_rx_count);
+        waitForGroups(pool, card);
+        return;
+    }
+    while (!waitForGroupsTimed(pool, card, ckpt_interval))
+    {
+        saveCheckpoint(ckpt_file, state);
+    }
+}
 
-        // prepare threads
-        pthread_t thread[max_threads];
-        struct thread_args thread_args[max_threads];
-        int i;
-        for (i = 0; i < max_threads; i++)
+/**
+ * joins threads of startAnalysis and keeps the peak memory used by the arena
+ * for the candidates of searchCutsets in each thread in arena_peaks
+ */
+void stopAnalysis(int max_threads, struct task_pool* pool, pthread_t* thread,
+        struct thread_args* thread_args, size_t* arena_peaks)
+{
+    int i;
+    for (i = 0; i < max_threads; i++)
+    {
+        pthread_join(thread[i], NULL);
+        if (thread_args[i].arena_peak > arena_peaks[i])
         {
-            thread_args[i].thread_id      = i;
-            thread_args[i].max_threads    = max_threads;
-            thread_args[i].bitlength      = bitlength;
-            thread_args[i].card           = card;
-            thread_args[i].max_card       = max_card;
-            thread_args[i].red_rx_count   = red_rx_count;
-            thread_args[i].start_indices  = start_indices;
-            thread_args[i].mcs_card_sum   = mcs_card_sum;
-            thread_args[i].reduced_matrix = reduced_matrix;
-            thread_args[i].cutsets        = cutsets;
+            arena_peaks[i] = thread_args[i].arena_peak;
         }
+    }
+    freeTaskPool(pool);
+}
 
-        resetStaticProgressVariables(mcs_card_sum[card]);
-
-        // start threads
-        for (i = 0; i < max_threads; i++)
+/**
+ * define start indices for cardinalities of a reduced matrix with the mcs
+ * of mcs_card_sum and red_rx_count reactions for length cardinalities
+ * cardinalities start with 0: card 1 = 0; card 2 = 1; ...
+ * in reduced matrix cardinality 2 starts in row 0 !!!
+ */
+void setStartIndices(unsigned long* start_indices, unsigned long*
+        mcs_card_sum, int red_rx_count, int length)
+{
+    int i;
+    for (i = 0; i < red_rx_count; i++)
+    {
+        if (i < 2)
         {
-            pthread_create(&thread[i], NULL, analyseMcs, 
-                    (void *)&thread_args[i]);
+            start_indices[i] = 0;
         }
-
-        // join threads
-        for (i = 0; i < max_threads; i++)
+        else
         {
-            pthread_join(thread[i], NULL);
+            start_indices[i] = start_indices[i-1] + mcs_card_sum[i-1];
         }
     }
+    for (i = red_rx_count; i < length; i++)
+    {
+        start_indices[i] = start_indices[red_rx_count - 1] +
+            mcs_card_sum[red_rx_count - 1];
+    }
 }
 
 /**
- * calculate number of all cutsets for given cardinality
+ * removes duplicate and non-minimal mcs read from a text file and reports
+ * the number of removed mcs
+ */
+void filterMcs(bitword* initial_mat, int* mcs_card, unsigned long*
+        mcs_card_sum, unsigned long* mcs_count, int rx_count)
+{
+    unsigned long duplicate_count;
+    unsigned long superset_count;
+    if (MCS_OK != filterMcsRows(initial_mat, mcs_card, mcs_card_sum,
+                mcs_count, rx_count, &duplicate_count, &superset_count))
+    {
+        quitError("Not enough free memory for filtering mcs\n", ERROR_RAM);
+    }
+    if (duplicate_count || superset_count)
+    {
+        fprintf(stderr, "Removed %lu duplicate and %lu non-minimal mcs\n",
+                duplicate_count, superset_count);
+    }
+}
+
+/**
+ * calculate number of cutsets for given cardinality that are given by the
+ * mcs and single knockouts without search
  */
-unsigned long getCutsets(int card, unsigned long** cutsets, unsigned long*
-        start_indices, unsigned long* mcs_card_sum, int total_rx_count)
+uint128 getBaseCutsets(int card, unsigned long* mcs_card_sum, int
+        total_rx_count)
 {
     // number of mcs with cardinality card
-    unsigned long card_cutsets = mcs_card_sum[card];
+    uint128 card_cutsets = mcs_card_sum[card];
     if (card > 0)
     {
         int i = 0;
         // consider single knockouts
         for (i = 0; i < mcs_card_sum[0]; i++)
         {
-            card_cutsets += choose( (total_rx_count - i - 1), card );
+            card_cutsets += chooseExact( (total_rx_count - i - 1), card );
         }
+    }
+    return card_cutsets;
+}
+
+/**
+ * calculate number of all cutsets for given cardinality
+ */
+uint128 getCutsets(int card, uint128* cutsets, unsigned long* start_indices,
+        unsigned long* mcs_card_sum, int total_rx_count, int max_card)
+{
+    uint128 card_cutsets = getBaseCutsets(card, mcs_card_sum,
+            total_rx_count);
+    if (card > 0)
+    {
         unsigned long li = 0;
         for (li = start_indices[1]; li < start_indices[card]; li++)
         {
-            card_cutsets += cutsets[li][card];
+            card_cutsets += cutsets[li * max_card + card];
         }
     }
     return card_cutsets;
 }
 
-int main (int argc, char *argv[])
+/**
+ * calculate number of all cutsets for given cardinality by the sets of
+ * reduced reactions containing a mcs that are counted by the decision
+ * diagram or the components, these sets include the mcs counted in the base
+ * cutsets
+ */
+uint128 getReducedCutsets(int card, uint128* reduced_cutsets, unsigned long*
+        mcs_card_sum, int total_rx_count)
 {
-    // read arguments
-    char *optv[MAX_ARGS] = { "-i", "-m", "-l", "-t", "-o" };
-    char *optd[MAX_ARGS] = { "mcs file in form of 000110", 
-        "maximum number of knockouts [default=number of reactions]", 
-        "lambda = weighting factor ( > 0 ) [default=0.5]",
-        "number of threads [default=1]",
-        "output file"};
-    char *optr[MAX_ARGS];
+    uint128 card_cutsets = getBaseCutsets(card, mcs_card_sum,
+            total_rx_count) + reduced_cutsets[card + 1];
+    if (card > 0)
+    {
+        card_cutsets -= mcs_card_sum[card];
+    }
+    return card_cutsets;
+}
+
+/**
+ * returns the matrix searched for the mcs_count rows of mat with rx_count
+ * reactions, reactions with equal columns are merged into one column
+ *   - column_count gets the number of columns of the returned matrix
+ *   - column_weights gets the number of reactions of each column, it is
+ *     NULL if no reactions are merged and mat is returned
+ */
+bitword* getSearchMatrix(bitword* mat, unsigned long mcs_count, int rx_count,
+        int* column_count, int** column_weights)
+{
+    bitword* comp_mat = NULL;
+    *column_weights   = malloc((rx_count + 1) * sizeof(int));
+    if ( (NULL == *column_weights) || (MCS_OK != compressMatrix(mat,
+                    mcs_count, rx_count, &comp_mat, column_count,
+                    *column_weights)) )
+    {
+        quitError("Not enough free memory for compressed matrix\n",
+                ERROR_RAM);
+    }
+    if (NULL == comp_mat)
+    {
+        free(*column_weights);
+        *column_weights = NULL;
+        return mat;
+    }
+    return comp_mat;
+}
+
+/**
+ * counts all sets of the rx_count reactions of a component that contain one
+ * of its mcs_count mcs by the cutset search into counts[0 .. max_card]
+ *   - the rows of component_mat are sorted by cardinality and contain no
+ *     single knockouts
+ *   - the threads of startAnalysis are joined before returning
+ */
+void searchComponent(bitword* component_mat, unsigned long mcs_count, int
+        rx_count, int max_card, int max_threads, struct progress* progress,
+        struct search_stats* stats, struct task_pool* pool, pthread_t* thread,
+        struct thread_args* thread_args, size_t* arena_peaks, uint128* counts)
+{
+    int            word_count    = getWordCount(rx_count);
+    int            length        = rx_count > max_card ? rx_count : max_card;
+    unsigned long* mcs_card_sum  = calloc(length + 1, sizeof(unsigned long));
+    unsigned long* start_indices = malloc((length + 1) *
+            sizeof(unsigned long));
+    uint128*       cutsets       = calloc(mcs_count * max_card + 1,
+            sizeof(uint128));
+    uint16_t*      row_cards     = calloc(mcs_count + 1, sizeof(uint16_t));
+    unsigned long* root_pending  = calloc(mcs_count + 1,
+            sizeof(unsigned long));
+    if ( (NULL == mcs_card_sum) || (NULL == start_indices) || (NULL ==
+                cutsets) || (NULL == row_cards) || (NULL == root_pending) )
+    {
+        quitError("Not enough free memory for cutsets\n", ERROR_RAM);
+    }
+    unsigned long li;
+    for (li = 0; li < mcs_count; li++)
+    {
+        mcs_card_sum[bitsetCount(SLABROW(component_mat, li, word_count),
+                word_count) - 1]++;
+    }
+    setStartIndices(start_indices, mcs_card_sum, rx_count, length);
+
+    int      column_count;
+    int*     column_weights;
+    bitword* search_mat        = getSearchMatrix(component_mat, mcs_count,
+            rx_count, &column_count, &column_weights);
+    int      column_word_count = getWordCount(column_count);
+
+    struct mcs_index  mcs_index;
+    struct mcs_index* rx_index = NULL;
+    if ( (column_word_count > INDEX_COST / 2) && initMcsIndex(&mcs_index,
+                search_mat, mcs_count, column_count, column_word_count) )
+    {
+        rx_index = &mcs_index;
+    }
+    struct set_trie  mcs_trie;
+    struct set_trie* subset_trie = NULL;
+    if (initSetTrie(&mcs_trie, search_mat, mcs_count, column_count,
+                column_word_count))
+    {
+        subset_trie = &mcs_trie;
+    }
+
+    startAnalysis(search_mat, rx_index, subset_trie, rx_count, column_count,
+            column_weights, start_indices, max_threads, max_card, 0, 1,
+            cutsets, row_cards, root_pending, progress, stats, pool, thread,
+            thread_args);
+    waitForGroups(pool, max_card - 1);
+    stopAnalysis(max_threads, pool, thread, thread_args, arena_peaks);
+
+    int card;
+    counts[0] = 0;
+    for (card = 0; card < max_card; card++)
+    {
+        counts[card + 1] = getCutsets(card, cutsets, start_indices,
+                mcs_card_sum, rx_count, max_card);
+    }
+
+    if (rx_index)
+    {
+        freeMcsIndex(rx_index);
+    }
+    if (subset_trie)
+    {
+        freeSetTrie(subset_trie);
+    }
+    if (search_mat != component_mat)
+    {
+        free(search_mat);
+    }
+    free(column_weights);
+    free(mcs_card_sum);
+    free(start_indices);
+    free(cutsets);
+    free(row_cards);
+    free(root_pending);
+}
+
+/**
+ * multiplies the counts of sets of two disjoint sets of reactions
+ * counts[d] becomes the number of unions of d reactions
+ */
+void convolveCounts(uint128* counts, uint128* other, int max_card)
+{
+    int d;
+    int j;
+    for (d = max_card; d >= 0; d--)
+    {
+        uint128 sum = 0;
+        for (j = 0; j <= d; j++)
+        {
+            sum += counts[j] * other[d - j];
+        }
+        counts[d] = sum;
+    }
+}
+
+/**
+ * counts all sets of reduced reactions that contain a mcs into
+ * reduced_cutsets[0 .. max_card] by the sets of each component
+ *   - a set contains no mcs if its reactions of each component contain
+ *     none, these sets are counted by the convolution of the components
+ *     and the free reactions of no mcs
+ *   - components are counted by the decision diagram of at most zdd_bytes
+ *     if use_zdd or by the search of all threads otherwise or if the
+ *     diagram needs more
+ */
+void countComponentCutsets(struct mcs_components* components, bitword*
+        reduced_mat, unsigned long red_mcs_count, int red_rx_count, int
+        max_card, int use_zdd, size_t zdd_bytes, int max_threads, struct
+        progress* progress, struct search_stats* stats, struct task_pool*
+        pool, pthread_t* thread, struct thread_args* thread_args, size_t*
+        arena_peaks, unsigned long* zdd_nodes, uint128* reduced_cutsets)
+{
+    int      red_word_count = getWordCount(red_rx_count);
+    uint128* counts         = malloc((max_card + 1) * sizeof(uint128));
+    uint128* no_cutsets     = calloc(max_card + 1, sizeof(uint128));
+    if ( (NULL == counts) || (NULL == no_cutsets) )
+    {
+        quitError("Not enough free memory for components\n", ERROR_RAM);
+    }
+    no_cutsets[0] = 1;
+
+    int c;
+    int d;
+    for (c = 0; c < components->component_count; c++)
+    {
+        int           rx_count  = components->rx_counts[c];
+        unsigned long mcs_count = components->mcs_counts[c];
+        bitword*      sub_mat   = newComponentMatrix(components, c,
+                reduced_mat, red_mcs_count, red_word_count);
+        if (NULL == sub_mat)
+        {
+            quitError("Not enough free memory for components\n", ERROR_RAM);
+        }
+        unsigned long node_count = 0;
+        if (use_zdd && (ZDD_OK == countCutsetsByZdd(sub_mat, mcs_count,
+                        rx_count, getWordCount(rx_count), max_card,
+                        zdd_bytes, counts, &node_count)))
+        {
+            *zdd_nodes += node_count;
+        }
+        else
+        {
+            if (use_zdd)
+            {
+                fprintf(stderr, "Decision diagram exceeds --zdd-memory, \
+component is searched\n");
+            }
+            searchComponent(sub_mat, mcs_count, rx_count, max_card,
+                    max_threads, progress, stats, pool, thread, thread_args,
+                    arena_peaks, counts);
+        }
+        free(sub_mat);
+
+        for (d = 0; d <= max_card; d++)
+        {
+            counts[d] = chooseExact(rx_count, d) - counts[d];
+        }
+        convolveCounts(no_cutsets, counts, max_card);
+    }
+    for (d = 0; d <= max_card; d++)
+    {
+        counts[d] = chooseExact(components->free_rx_count, d);
+    }
+    convolveCounts(no_cutsets, counts, max_card);
+
+    for (d = 0; d <= max_card; d++)
+    {
+        reduced_cutsets[d] = chooseExact(red_rx_count, d) - no_cutsets[d];
+    }
+    free(counts);
+    free(no_cutsets);
+}
+
+/**
+ * calculate number of cutsets for given cardinality that are found by the
+ * search of the mcs of shard
+ */
+uint128 getShardCutsets(int card, uint128* cutsets, unsigned long*
+        start_indices, int max_card, int shard, int shard_count)
+{
+    uint128       card_cutsets = 0;
+    unsigned long last         = start_indices[max_card - 1];
+    unsigned long li;
+    for (li = start_indices[1]; li < start_indices[card]; li++)
+    {
+        if (getShardOfMcs(last - 1 - li, shard_count) == shard)
+        {
+            card_cutsets += cutsets[li * max_card + card];
+        }
+    }
+    return card_cutsets;
+}
+
+int main (int argc, char *argv[])
+{
+    // read arguments
+    char *optv[MAX_ARGS] = { "-i", "-m", "-l", "-t", "-o", "-k",
+        "--tolerance", "--checkpoint", "--resume", "--extend", "--shard",
+        "--progress", "--stats", "--engine", "--reorder", "--sample",
+        "--exact", "--sample-error", "--zdd-memory",
+        "--checkpoint-interval" };
+    char *optd[MAX_ARGS] = { "mcs file in form of 000110 or converted by mcs2bin", 
+        "maximum number of knockouts [default=number of reactions]", 
+        "lambda = weighting factor ( > 0 ) [default=0.5]",
+        "number of threads [default=1]",
+        "output file",
+        "bitset kernel: scalar, popcnt, avx2, avx512 [default=fastest \
+supported by cpu]",
+        "stop at the number of knockouts where the left weight bounds the \
+error of total P(f) below this value [optional]",
+        "checkpoint file written periodically and at the end [optional]",
+        "continue an interrupted run from this checkpoint, -m is taken from \
+the checkpoint [optional]",
+        "reuse the cutsets of this checkpoint of a run with lower -m, all \
+mcs are searched again for the missing cardinalities [optional]",
+        "analyse only shard k of N as k/N and write its partial cutsets to \
+the output file for mergeFailureShards [optional]",
+        "write progress as one json line per second to this file, - for \
+stderr [optional]",
+        "write json statistics of the search per cardinality and thread to \
+this file, needs a build by make stats [optional]",
+        "engine counting the cutsets: search or zdd, zdd counts all sets \
+containing a mcs on a decision diagram [default=search]",
+        "reorder reduced matrix: none, columns by frequency of reactions, \
+rows sorted by reactions within cardinalities or both [default=none]",
+        "estimate the cutsets of knockouts above --exact by at most this \
+number of random knockout sets per number of knockouts [optional]",
+        "number of knockouts counted exactly with --sample [default=3]",
+        "stop sampling a number of knockouts when the 95% confidence \
+interval is within this relative error of P(f) [default=0.01]",
+        "memory of the decision diagram in MB, the search counts the \
+cutsets if it needs more [default=1024]",
+        "seconds between checkpoints written while waiting for a number \
+of knockouts [default=300]"};
+    char *optr[MAX_ARGS];
     char *description = "Calculate failure probability of the network for \
                          increasing number of knockouts";
     char *usg = "failureProbabilityByMcs -i mcs.csv -m 6 -l 0.1 -t 6 -o failure.out";
@@ -801,11 +1273,124 @@ int main (int argc, char *argv[])
         quitError("Missing argument\n", ERROR_ARGS);
     }
 
-    if (!isValidInputFile(optr[0]))
+    // map mcs file into memory
+    struct mcs_file mcs_file;
+    if (!openMcsFile(optr[0], &mcs_file))
+    {
+        quitError("Error in opening file\n", ERROR_FILE);
+    }
+    if (!isValidMcsFile(&mcs_file))
     {
         quitError("MCS file is not valid\n", ERROR_FILE);
     }
 
+    // define shard of mcs to analyse, shards are counted from 0 internally
+    int shard       = 0;
+    int shard_count = 1;
+    if (optr[10])
+    {
+        if ( (sscanf(optr[10], "%d/%d", &shard, &shard_count) != 2) ||
+             (shard < 1) || (shard > shard_count) )
+        {
+            quitError("Shard needs to be given as k/N with 1 <= k <= N\n\n",
+                    ERROR_ARGS);
+        }
+        shard--;
+    }
+
+    // define engine counting the cutsets
+    // the diagram is built at once, it has no per mcs results to share
+    int use_zdd = 0;
+    if (optr[13])
+    {
+        if (!strcmp(optr[13], "zdd"))
+        {
+            use_zdd = 1;
+        }
+        else if (strcmp(optr[13], "search"))
+        {
+            quitError("Engine needs to be search or zdd\n\n", ERROR_ARGS);
+        }
+    }
+    if (use_zdd && (optr[7] || optr[8] || optr[9] || optr[10] || optr[12]))
+    {
+        quitError("Engine zdd does not support --checkpoint, --resume, \
+--extend, --shard and --stats\n\n", ERROR_ARGS);
+    }
+    size_t zdd_bytes = ZDD_DEFAULT_MB << 20;
+    if (optr[18])
+    {
+        long zdd_mb = atol(optr[18]);
+        if (zdd_mb < 1)
+        {
+            quitError("Memory of decision diagram < 1 MB\n\n", ERROR_ARGS);
+        }
+        zdd_bytes = (size_t)zdd_mb << 20;
+    }
+
+    // define reordering of the reduced matrix
+    int order_columns = 0;
+    int order_rows    = 0;
+    if (optr[14])
+    {
+        order_columns = !strcmp(optr[14], "columns") || !strcmp(optr[14],
+                "both");
+        order_rows    = !strcmp(optr[14], "rows") || !strcmp(optr[14],
+                "both");
+        if (!order_columns && !order_rows && strcmp(optr[14], "none"))
+        {
+            quitError("Reorder needs to be none, columns, rows or both\n\n",
+                    ERROR_ARGS);
+        }
+    }
+
+    // define sampling of the knockouts above exact_card
+    unsigned long max_samples  = 0;
+    int           exact_card   = 3;
+    double        sample_error = 0.01;
+    if (optr[15])
+    {
+        max_samples = strtoul(optr[15], NULL, 10);
+        if (max_samples < 1)
+        {
+            quitError("Number of samples < 1\n\n", ERROR_ARGS);
+        }
+    }
+    if ( (optr[16] || optr[17]) && !optr[15] )
+    {
+        quitError("--exact and --sample-error need --sample\n\n",
+                ERROR_ARGS);
+    }
+    if (optr[16])
+    {
+        exact_card = atoi(optr[16]);
+        if (exact_card < 1)
+        {
+            quitError("Number of exact knockouts < 1\n\n", ERROR_ARGS);
+        }
+    }
+    if (optr[17])
+    {
+        sample_error = atof(optr[17]);
+        if (sample_error <= 0)
+        {
+            quitError("Sample error needs to be greater than zero\n\n",
+                    ERROR_ARGS);
+        }
+    }
+    if (optr[15] && (optr[7] || optr[8] || optr[9] || optr[10]))
+    {
+        quitError("Sampling does not support --checkpoint, --resume, \
+--extend and --shard\n\n", ERROR_ARGS);
+    }
+
+#ifndef SEARCH_STATS
+    if (optr[12])
+    {
+        quitError("Statistics need a build by make stats\n\n", ERROR_ARGS);
+    }
+#endif
+
     // open output file
     FILE *file_out = fopen(optr[4], "w");
     if (!file_out)
@@ -814,7 +1399,7 @@ int main (int argc, char *argv[])
     }
 
     // define number of reactions
-    int rx_count = getReactionCount(optr[0]);
+    int rx_count = mcs_file.rx_count;
     if (rx_count < 1)
     {
         quitError("\nNumber of reactions = 0. That is not possible\n\n",
@@ -836,6 +1421,51 @@ int main (int argc, char *argv[])
         max_card = rx_count;
     }
 
+    // read checkpoint of a previous run
+    // new checkpoints replace the read one if no other file is given
+    struct checkpoint ckpt;
+    memset(&ckpt, 0, sizeof(struct checkpoint));
+    char* ckpt_load = optr[8] ? optr[8] : optr[9];
+    char* ckpt_file = optr[7] ? optr[7] : ckpt_load;
+    if (optr[8] && optr[9])
+    {
+        quitError("Use either --resume or --extend\n\n", ERROR_ARGS);
+    }
+    int ckpt_interval = CKPT_INTERVAL;
+    if (optr[19])
+    {
+        ckpt_interval = atoi(optr[19]);
+        if (ckpt_interval < 1)
+        {
+            quitError("Checkpoint interval < 1 second\n\n", ERROR_ARGS);
+        }
+    }
+    if (ckpt_load)
+    {
+        int ckpt_status = readCheckpoint(ckpt_load, &ckpt);
+        if (CKPT_ERROR_FILE == ckpt_status)
+        {
+            quitError("Error in opening checkpoint\n", ERROR_FILE);
+        }
+        if (CKPT_ERROR_RAM == ckpt_status)
+        {
+            quitError("Not enough free memory for checkpoint\n", ERROR_RAM);
+        }
+        if ( (CKPT_OK != ckpt_status) || (ckpt.rx_count != rx_count) )
+        {
+            quitError("Checkpoint does not match mcs file\n", ERROR_INPUT);
+        }
+        if (optr[8])
+        {
+            if (optr[1] && (max_card != ckpt.max_card))
+            {
+                quitError("Maximum number of knockouts differs from \
+checkpoint, use --extend\n\n", ERROR_ARGS);
+            }
+            max_card = ckpt.max_card;
+        }
+    }
+
     // define lambda for weighting function
     double lambda = 0.5;
     if (optr[2])
@@ -847,6 +1477,79 @@ int main (int argc, char *argv[])
         quitError("lambda needs to be greater than zero\n\n", ERROR_ARGS);
     }
 
+    // stop at the number of deletions where the weight of all further
+    // deletions is below the tolerance, as P(f) <= 1 this weight bounds the
+    // error of total P(f)
+    if (optr[6])
+    {
+        double tolerance = atof(optr[6]);
+        if (tolerance <= 0)
+        {
+            quitError("tolerance needs to be greater than zero\n\n",
+                    ERROR_ARGS);
+        }
+        int d;
+        for (d = 1; d < max_card; d++)
+        {
+            if (getTailWeight(lambda, d) <= tolerance)
+            {
+                break;
+            }
+        }
+        if (d < max_card)
+        {
+            fprintf(stderr, "Number of maximum knockouts reduced to %d: \
+error bound %.3e below tolerance\n", d, getTailWeight(lambda, d));
+            max_card = d;
+        }
+        else
+        {
+            fprintf(stderr, "Tolerance not reached: error bound %.3e with %d \
+knockouts\n", getTailWeight(lambda, max_card), max_card);
+        }
+    }
+
+    // all counts are bounded by the number of possible cutsets
+    // limit number of deletions to keep them exact in 128 bit
+    int k;
+    for (k = 1; k <= max_card; k++)
+    {
+        if (chooseExact(rx_count, k) == UINT128_MAX_VALUE)
+        {
+            fprintf(stderr, "Number of maximum knockouts reduced to %d: \
+number of cutsets exceeds 128 bit\n", k - 1);
+            max_card = k - 1;
+            break;
+        }
+    }
+
+    // precompute binomials needed for counting cutsets
+    // the table grows with max_card, so it is built for the capped one
+    if (!initBinomTable(rx_count, max_card))
+    {
+        quitError("Not enough free memory for binomial table\n", ERROR_RAM);
+    }
+    if (ckpt_load && (max_card < ckpt.max_card))
+    {
+        quitError("Maximum number of knockouts is lower than in checkpoint\n\n",
+                ERROR_ARGS);
+    }
+
+    // knockouts above exact_card are sampled, the reduced matrix keeps the
+    // mcs up to sample_card while max_card bounds the exact counts
+    int sample_card = 0;
+    if (max_samples && (exact_card < max_card))
+    {
+        sample_card = max_card;
+        max_card    = exact_card;
+    }
+    else if (max_samples)
+    {
+        fprintf(stderr, "Sampling skipped: all %d knockouts are counted \
+exactly with --exact %d\n", max_card, exact_card);
+    }
+    int table_card  = sample_card ? sample_card : max_card;
+
     // define number of threads to use
     int max_threads = 1;
     if (optr[3])
@@ -858,9 +1561,23 @@ int main (int argc, char *argv[])
         quitError("Number of threads < 1\n\n", ERROR_THREADS);
     }
 
+    // define bitset kernels used in cutset search
+    if (optr[5])
+    {
+        if (!setBitsetKernel(optr[5]))
+        {
+            quitError("Bitset kernel is unknown or not supported by cpu\n\n",
+                    ERROR_ARGS);
+        }
+    }
+    else
+    {
+        initBitsetKernels();
+    }
+
     // allocate memory for bit matrix and cardinalities
-    int            bitarray_size = getBitsize(rx_count);
-    char**         initial_mat   = NULL;
+    int            word_count    = getWordCount(rx_count);
+    bitword*       initial_mat   = NULL;
     int*           mcs_card      = NULL;
     unsigned long  mcs_count     = 0;
     unsigned long* mcs_card_sum  = calloc(1, rx_count * sizeof(unsigned long));
@@ -870,100 +1587,446 @@ int main (int argc, char *argv[])
     }
 
     // read mcs matrix
-    readInitialMatrix(rx_count, &mcs_count, &initial_mat, &mcs_card,
-            mcs_card_sum, bitarray_size, optr[0]);
+    int i;
+    if (mcs_file.is_binary)
+    {
+        mcs_count = mcs_file.mcs_count;
+        for (i = 0; i < rx_count; i++)
+        {
+            mcs_card_sum[i] = mcs_file.card_sum[i];
+        }
+    }
+    else
+    {
+        int read_status = readMcsFile(&mcs_file, max_threads, &mcs_count,
+                &initial_mat, &mcs_card, mcs_card_sum);
+        if (MCS_ERROR_RAM == read_status)
+        {
+            quitError("Not enough free memory for mcs matrix\n", ERROR_RAM);
+        }
+        if (MCS_OK != read_status)
+        {
+            quitError("MCS file is not valid\n", ERROR_INPUT);
+        }
+        closeMcsFile(&mcs_file);
+        filterMcs(initial_mat, mcs_card, mcs_card_sum, &mcs_count,
+                rx_count);
+    }
 
     // prepare matrix reduction
     int           red_rx_count      = rx_count - mcs_card_sum[0];
-    int           red_bitarray_size = getBitsize(red_rx_count);
-    unsigned long red_mcs_count     = mcs_count - mcs_card_sum[0];
-    int i;
-    for (i = max_card; i < rx_count; i++)
+    int           red_word_count    = getWordCount(red_rx_count);
+    unsigned long matrix_count      = mcs_count - mcs_card_sum[0];
+    for (i = table_card; i < rx_count; i++)
+    {
+        matrix_count -= mcs_card_sum[i];
+    }
+    unsigned long red_mcs_count     = matrix_count;
+    for (i = max_card; i < table_card; i++)
     {
         red_mcs_count -= mcs_card_sum[i];
     }
+    if (matrix_count >= UINT32_MAX)
+    {
+        quitError("Number of mcs exceeds 32 bit\n", ERROR_INPUT);
+    }
 
     // reduce matrix
-    char** reduced_mat = malloc(red_mcs_count * sizeof(char *));
-    processMatrix(rx_count, mcs_count, initial_mat, mcs_card, mcs_card_sum,
-            bitarray_size, red_rx_count, red_mcs_count, reduced_mat,
-            red_bitarray_size, max_card);
+    // binary files contain the reduced matrix sorted by cardinality, its
+    // rows are used in place
+    // the reduced matrix is one slab with red_word_count words per row
+    bitword* reduced_mat = NULL;
+    if (mcs_file.is_binary)
+    {
+        if ( (red_rx_count != mcs_file.red_rx_count) || 
+             (matrix_count > mcs_file.row_count) )
+        {
+            quitError("MCS file is not valid\n", ERROR_INPUT);
+        }
+        reduced_mat = mcs_file.rows;
+    }
+    else
+    {
+        int* left_cols = malloc((red_rx_count + 1) * sizeof(int));
+        reduced_mat    = newBitsetSlab(matrix_count, red_word_count);
+        if ( (NULL == left_cols) || (NULL == reduced_mat) ||
+                (MCS_OK != processMatrix(rx_count,
+                        mcs_count, initial_mat, mcs_card, mcs_card_sum,
+                        word_count, red_rx_count, reduced_mat, red_word_count,
+                        table_card, left_cols)) )
+        {
+            quitError("Not enough free memory for reduced matrix\n",
+                    ERROR_RAM);
+        }
+        free(left_cols);
 
-    // free memory of initial matrix
-    unsigned long li;
-    for (li=0; li<mcs_count; li++)
+        // free memory of initial matrix
+        free(initial_mat);
+        initial_mat = NULL;
+    }
+
+    // reorder the reduced matrix, counts do not depend on the order of
+    // reactions and of mcs of equal cardinality
+    if (order_columns || order_rows)
     {
-        free(initial_mat[li]);
+        bitword* ord_mat = NULL;
+        if (MCS_OK != reorderMatrix(reduced_mat, matrix_count, red_rx_count,
+                    order_columns, order_rows, &ord_mat))
+        {
+            quitError("Not enough free memory for reordered matrix\n",
+                    ERROR_RAM);
+        }
+        if (!mcs_file.is_binary)
+        {
+            free(reduced_mat);
+        }
+        reduced_mat = ord_mat;
     }
-    free(initial_mat);
-    initial_mat = NULL;
 
     // define start indices for cardinalities in reduced matrix
-    // cardinalities start with 0: card 1 = 0; card 2 = 1; ...
-    // in reduced matrix cardinality 2 starts in row 0 !!!
     unsigned long* start_indices = malloc(rx_count * sizeof(unsigned long));
-    for (i = 0; i < red_rx_count; i++)
+    if (NULL == start_indices)
     {
-        if (i < 2)
+        quitError("Not enough free memory for start indices\n", ERROR_RAM);
+    }
+    setStartIndices(start_indices, mcs_card_sum, red_rx_count, rx_count);
+
+    // mcs that share no reaction form independent components, their cutsets
+    // are counted separately for each component
+    // checkpoints and shards refer to the rows of the whole reduced matrix
+    struct mcs_components components;
+    int                   use_components  = 0;
+    int                   component_count = 0;
+    if ( !optr[7] && !optr[8] && !optr[9] && !optr[10] )
+    {
+        if (!initMcsComponents(&components, reduced_mat, red_mcs_count,
+                    red_rx_count, red_word_count))
         {
-            start_indices[i] = 0;
+            quitError("Not enough free memory for components\n", ERROR_RAM);
         }
-        else
+        component_count = components.component_count;
+        use_components  = component_count > 1;
+        if (!use_components)
         {
-            start_indices[i] = start_indices[i-1] + mcs_card_sum[i-1];
+            freeMcsComponents(&components);
         }
     }
-    for (i = red_rx_count; i < rx_count; i++)
+
+    // allocate memory for cutsets
+    // cutsets of mcs li and cardinality card are stored at
+    // cutsets[li * max_card + card]
+    uint128* cutsets = calloc(use_components ? 1 : red_mcs_count * max_card
+            + 1, sizeof(uint128));
+    if (NULL == cutsets)
     {
-        start_indices[i] = start_indices[red_rx_count - 1] +
-            mcs_card_sum[red_rx_count - 1];
+        quitError("Not enough free memory for cutsets\n", ERROR_RAM);
     }
 
-    // allocate memory for cutsets
-    unsigned long** cutsets = calloc(red_mcs_count, sizeof(double*));
-    if (red_mcs_count > 0)
+    // number of complete cardinalities of the cutsets of each mcs and number
+    // of unfinished tasks of each mcs
+    uint16_t*      row_cards    = calloc(red_mcs_count + 1, sizeof(uint16_t));
+    unsigned long* root_pending = calloc(red_mcs_count + 1,
+            sizeof(unsigned long));
+    if ( (NULL == row_cards) || (NULL == root_pending) )
+    {
+        quitError("Not enough free memory for cutsets\n", ERROR_RAM);
+    }
+
+    // take complete cutsets of checkpoint, its mcs are the first mcs of
+    // the reduced matrix if it was written for the same mcs
+    if (ckpt_load)
     {
-        for (li = 0; li < red_mcs_count; li++)
+        if ( (ckpt.red_rx_count != red_rx_count) || (ckpt.row_count >
+                    red_mcs_count) || (ckpt.hash != hashMcsRows(reduced_mat,
+                        ckpt.row_count, red_word_count, mcs_card_sum,
+                        rx_count)) )
         {
-            cutsets[li] = calloc(rx_count, sizeof(double));
+            quitError("Checkpoint does not match mcs file\n", ERROR_INPUT);
         }
-        if (NULL == cutsets[red_mcs_count - 1])
+        unsigned long li;
+        for (li = 0; li < ckpt.row_count; li++)
         {
-            quitError("Not enough free memory for cutsets\n", ERROR_RAM);
+            row_cards[li] = ckpt.row_cards[li];
+            memcpy(cutsets + li * max_card, ckpt.cutsets + li *
+                    ckpt.max_card, row_cards[li] * sizeof(uint128));
         }
+        freeCheckpoint(&ckpt);
+    }
+    struct checkpoint state;
+    state.hash         = hashMcsRows(reduced_mat, red_mcs_count,
+            red_word_count, mcs_card_sum, rx_count);
+    state.rx_count     = rx_count;
+    state.red_rx_count = red_rx_count;
+    state.max_card     = max_card;
+    state.row_count    = red_mcs_count;
+    state.row_cards    = row_cards;
+    state.cutsets      = cutsets;
+
+    // the search merges reactions with equal columns, components are
+    // compressed separately
+    bitword* search_mat     = reduced_mat;
+    int      column_count   = red_rx_count;
+    int*     column_weights = NULL;
+    if (!use_zdd && !use_components)
+    {
+        search_mat = getSearchMatrix(reduced_mat, red_mcs_count,
+                red_rx_count, &column_count, &column_weights);
+    }
+    int column_word_count = getWordCount(column_count);
+
+    // index mcs by reactions to skip mcs with stored reactions
+    // the search runs without index if it does not fit into memory
+    struct mcs_index  mcs_index;
+    struct mcs_index* rx_index = NULL;
+    if ( !use_zdd && !use_components && (column_word_count > INDEX_COST /
+                2) && initMcsIndex(&mcs_index, search_mat, red_mcs_count,
+                column_count, column_word_count) )
+    {
+        rx_index = &mcs_index;
     }
 
-    int line_length = 111;
+    // set trie of the mcs to reject combinations covering a mcs
+    struct set_trie  mcs_trie;
+    struct set_trie* subset_trie = NULL;
+    if ( !use_zdd && !use_components && initSetTrie(&mcs_trie, search_mat,
+                red_mcs_count, column_count, column_word_count) )
+    {
+        subset_trie = &mcs_trie;
+    }
+
+    // set trie of all mcs of the reduced matrix to test sampled knockouts
+    // the rows are scanned if it does not fit into memory
+    struct set_trie       sample_trie;
+    struct set_trie*      sample_subsets = NULL;
+    struct sample_result* samples        = NULL;
+    if (sample_card)
+    {
+        samples = calloc(sample_card - max_card, sizeof(struct
+                    sample_result));
+        if (NULL == samples)
+        {
+            quitError("Not enough free memory for samples\n", ERROR_RAM);
+        }
+        if (initSetTrie(&sample_trie, reduced_mat, matrix_count,
+                    red_rx_count, red_word_count))
+        {
+            sample_subsets = &sample_trie;
+        }
+    }
 
-    printHeader(file_out, line_length, lambda);
+    int line_length = sample_card ? 141 : 111;
+
+    if (!optr[10])
+    {
+        printHeader(file_out, line_length, lambda, sample_card > 0);
+    }
+
+    // progress of the analysis is reported by a separate thread
+    struct progress progress;
+    FILE*           progress_stream = NULL;
+    if (optr[11])
+    {
+        progress_stream = strcmp(optr[11], "-") ? fopen(optr[11], "w") :
+            stderr;
+        if (!progress_stream)
+        {
+            quitError("Error in opening progress file\n", ERROR_FILE);
+        }
+    }
+    if (!initProgress(&progress, max_threads, progress_stream))
+    {
+        quitError("Not enough free memory for progress\n", ERROR_RAM);
+    }
+
+    // statistics of the search of each thread for the mcs of each
+    // cardinality and time until the cutsets of each cardinality are known
+    // they are only counted by builds with SEARCH_STATS
+    struct search_stats* stats        = NULL;
+    double*              wall_seconds = NULL;
+#ifdef SEARCH_STATS
+    stats        = calloc(max_threads * max_card, sizeof(struct search_stats));
+    wall_seconds = calloc(max_card, sizeof(double));
+    if ( (NULL == stats) || (NULL == wall_seconds) )
+    {
+        quitError("Not enough free memory for statistics\n", ERROR_RAM);
+    }
+#endif
+
+    // start calculation of cutsets of all mcs
+    struct task_pool    pool;
+    pthread_t*          thread      = malloc(max_threads * sizeof(pthread_t));
+    struct thread_args* thread_args = malloc(max_threads *
+            sizeof(struct thread_args));
+    size_t*             arena_peaks = calloc(max_threads, sizeof(size_t));
+    if ( (NULL == thread) || (NULL == thread_args) || (NULL == arena_peaks) )
+    {
+        quitError("Not enough free memory for threads\n", ERROR_RAM);
+    }
+    int card;
+    if (!use_zdd && !use_components)
+    {
+        startAnalysis(search_mat, rx_index, subset_trie, red_rx_count,
+                column_count, column_weights, start_indices, max_threads,
+                max_card, shard, shard_count, cutsets, row_cards,
+                root_pending, &progress, stats, &pool, thread, thread_args);
+    }
+
+    // count all sets of reduced reactions containing a mcs by the
+    // components or by the diagram
+    uint128*      reduced_cutsets = NULL;
+    unsigned long zdd_nodes       = 0;
+    if (use_components || use_zdd)
+    {
+        reduced_cutsets = malloc((max_card + 1) * sizeof(uint128));
+        if (NULL == reduced_cutsets)
+        {
+            quitError("Not enough free memory for cutsets\n", ERROR_RAM);
+        }
+    }
+    if (use_components)
+    {
+        if (!use_zdd)
+        {
+            startProgressReporter(&progress, start_indices[max_card - 1] -
+                    start_indices[1]);
+        }
+        countComponentCutsets(&components, reduced_mat, red_mcs_count,
+                red_rx_count, max_card, use_zdd, zdd_bytes, max_threads,
+                &progress,
+                stats, &pool, thread, thread_args, arena_peaks, &zdd_nodes,
+                reduced_cutsets);
+        freeMcsComponents(&components);
+    }
+    else if (use_zdd)
+    {
+        // the whole reduced matrix is searched like a single component
+        if (ZDD_OK != countCutsetsByZdd(reduced_mat, red_mcs_count,
+                    red_rx_count, red_word_count, max_card, zdd_bytes,
+                    reduced_cutsets, &zdd_nodes))
+        {
+            fprintf(stderr, "Decision diagram exceeds --zdd-memory, cutsets \
+are searched\n");
+            searchComponent(reduced_mat, red_mcs_count, red_rx_count,
+                    max_card, max_threads, &progress, stats, &pool, thread,
+                    thread_args, arena_peaks, reduced_cutsets);
+        }
+    }
+
+    // write partial cutsets of shard
+    if (optr[10])
+    {
+        uint128* base    = malloc(max_card * sizeof(uint128));
+        uint128* partial = malloc(max_card * sizeof(uint128));
+        if ( (NULL == base) || (NULL == partial) )
+        {
+            quitError("Not enough free memory for shard\n", ERROR_RAM);
+        }
+        for (card = 0; card < max_card; card++)
+        {
+            waitForCard(&pool, card, start_indices, ckpt_file,
+                    ckpt_interval, &state);
+            if (wall_seconds)
+            {
+                wall_seconds[card] = getProgressSeconds(&progress);
+            }
+            base[card]    = getBaseCutsets(card, mcs_card_sum, rx_count);
+            partial[card] = getShardCutsets(card, cutsets, start_indices,
+                    max_card, shard, shard_count);
+        }
+        stopProgressReporter(&progress);
+        struct shard_header header;
+        memset(&header, 0, sizeof(struct shard_header));
+        header.max_card    = max_card;
+        header.shard       = shard;
+        header.shard_count = shard_count;
+        header.hash        = state.hash;
+        header.rx_count    = rx_count;
+        header.lambda      = lambda;
+        if (SHARD_OK != writeShard(file_out, &header, base, partial))
+        {
+            quitError("Error in writing shard\n", ERROR_FILE);
+        }
+        printf("shard %d/%d written to %s\n", shard + 1, shard_count,
+                optr[4]);
+        free(base);
+        free(partial);
+    }
 
     // calculate failure probability
-    int    card;
     double total_weight_pF = 0;
-    double left_weight = 1 - exp(-lambda);
-    for (card = 0; card < max_card; card++)
+    for (card = 0; (card < table_card) && !optr[10]; card++)
     {
-        if (card > 0)
+        uint128 all_possible = chooseExact(rx_count, (card + 1));
+        uint128 card_cutsets;
+        double  failure;
+        double  failure_low;
+        double  failure_high;
+        if (card >= max_card)
         {
-            analyseCard(reduced_mat, red_mcs_count, red_rx_count, mcs_card_sum,
-                    start_indices, card, max_threads, max_card, cutsets);
+            // all exact counts are done, the bar would overwrite lines
+            stopProgressReporter(&progress);
+            struct sample_result* sample = &samples[card - max_card];
+            if (SAMPLE_OK != sampleCutsets(sample_subsets, reduced_mat,
+                        matrix_count, red_rx_count, rx_count, card + 1,
+                        max_samples, sample_error, max_threads, SAMPLE_SEED
+                        + card, sample))
+            {
+                quitError("Not enough free memory for samples\n",
+                        ERROR_RAM);
+            }
+            failure      = sample->fraction;
+            failure_low  = sample->low;
+            failure_high = sample->high;
+            card_cutsets = (uint128)(failure * (double)all_possible + 0.5);
+        }
+        else if (reduced_cutsets)
+        {
+            if (wall_seconds)
+            {
+                wall_seconds[card] = getProgressSeconds(&progress);
+            }
+            card_cutsets = getReducedCutsets(card, reduced_cutsets,
+                    mcs_card_sum, rx_count);
+        }
+        else
+        {
+            waitForCard(&pool, card, start_indices, ckpt_file,
+                    ckpt_interval, &state);
+            if (wall_seconds)
+            {
+                wall_seconds[card] = getProgressSeconds(&progress);
+            }
+            card_cutsets = getCutsets(card, cutsets, start_indices,
+                    mcs_card_sum, rx_count, max_card);
+        }
+        if (card < max_card)
+        {
+            failure      = (double)card_cutsets/(double)all_possible;
+            failure_low  = failure;
+            failure_high = failure;
+        }
+        // estimated numbers of cutsets are marked by a leading ~
+        char    card_cutsets_str[41] = "~";
+        char    all_possible_str[40];
+        char    bounds_str[40] = "";
+        sprintUint128(card_cutsets_str + (card >= max_card), card_cutsets);
+        sprintUint128(all_possible_str, all_possible);
+        if (sample_card)
+        {
+            sprintf(bounds_str, "     %.8f     %.8f", failure_low,
+                    failure_high);
         }
-        unsigned long card_cutsets = getCutsets(card, cutsets, start_indices,
-                mcs_card_sum, rx_count);
-        unsigned long all_possible = choose(rx_count, (card + 1));
-        double failure = (double)card_cutsets/(double)all_possible;
         double weight = getWeight(lambda, card+1);
         double weight_pF = weight * failure;
 
         total_weight_pF += weight_pF;
-        left_weight -= weight;
 
         // print result of failure probability of actual number of deletions to
         // stdout
-        clearProgress();
-        printf("%4d     %3d            %.10lf     %.8f     %25.0lu     %25.0lu",
-                rx_count, card + 1, weight_pF, failure, card_cutsets,
-                all_possible);
+        pauseProgress(&progress);
+        printf("%4d     %3d            %.10lf     %.8f     %25s     %25s%s",
+                rx_count, card + 1, weight_pF, failure, card_cutsets_str,
+                all_possible_str, bounds_str);
 
         // clear left overs from progress bars
         int oi;
@@ -976,37 +2039,108 @@ int main (int argc, char *argv[])
             printf("\b");
         }
         printf("\n");
+        resumeProgress(&progress);
 
         // print result of failure probability of actual number of deletions to
         // output file
         fprintf(file_out, 
-                "%4d     %3d            %.10lf     %.8f     %25.0lu     %25.0lu\n",
-                rx_count, card + 1, weight_pF, failure, card_cutsets,
-                all_possible);
+                "%4d     %3d            %.10lf     %.8f     %25s     %25s%s\n",
+                rx_count, card + 1, weight_pF, failure, card_cutsets_str,
+                all_possible_str, bounds_str);
         fflush(file_out);
     }
 
-    // weight cannot be less than 0; values < 0 are results of numerical
-    // instability of double values
-    if (left_weight < 0)
+    stopProgressReporter(&progress);
+
+    // weight of deletions that were not analysed, summed directly as the
+    // difference of total and analysed weight loses all digits for small
+    // weights
+    double left_weight = getTailWeight(lambda, table_card);
+
+    if (!optr[10])
     {
-        left_weight = 0;
+        printFooter(file_out, line_length, total_weight_pF, left_weight);
+    }
+    if (sample_card)
+    {
+        printSamples(file_out, samples, max_card, sample_card, lambda,
+                total_weight_pF);
     }
 
-    printFooter(file_out, line_length, total_weight_pF, left_weight);
+    if (use_components)
+    {
+        fprintf(stderr, "Independent components: %d\n", component_count);
+    }
+    if (use_zdd)
+    {
+        if (zdd_nodes)
+        {
+            fprintf(stderr, "Decision diagram nodes: %lu\n", zdd_nodes);
+        }
+    }
+    else if (!use_components)
+    {
+        stopAnalysis(max_threads, &pool, thread, thread_args, arena_peaks);
+    }
+    free(reduced_cutsets);
+    if (ckpt_file)
+    {
+        saveCheckpoint(ckpt_file, &state);
+    }
+    if (optr[12])
+    {
+        FILE* stats_out = fopen(optr[12], "w");
+        if (!stats_out)
+        {
+            quitError("Error in opening statistics file\n", ERROR_FILE);
+        }
+        writeStatsReport(stats_out, stats, max_threads, max_card,
+                mcs_card_sum, wall_seconds, bitsetKernelName, arena_peaks);
+        fclose(stats_out);
+    }
+    free(stats);
+    free(wall_seconds);
+    free(thread);
+    free(thread_args);
+    free(arena_peaks);
+    freeProgress(&progress);
+    if (progress_stream && (progress_stream != stderr))
+    {
+        fclose(progress_stream);
+    }
 
     // prepare exit
     fclose(file_out);
-    for (i = 0; i < red_mcs_count; i++)
+    if (!mcs_file.is_binary || order_columns || order_rows)
+    {
+        free(reduced_mat);
+    }
+    if (rx_index)
+    {
+        freeMcsIndex(rx_index);
+    }
+    if (subset_trie)
+    {
+        freeSetTrie(subset_trie);
+    }
+    if (sample_subsets)
+    {
+        freeSetTrie(sample_subsets);
+    }
+    free(samples);
+    if (search_mat != reduced_mat)
     {
-        free(cutsets[i]);
-        free(reduced_mat[i]);
+        free(search_mat);
     }
+    free(column_weights);
+    closeMcsFile(&mcs_file);
     free(cutsets);
-    free(reduced_mat);
+    free(row_cards);
+    free(root_pending);
     free(mcs_card);
     free(mcs_card_sum);
     free(start_indices);
+    freeBinomTable();
 
     return EXIT_SUCCESS;
 }
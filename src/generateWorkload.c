@@ -0,0 +1,348 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "generalFunctions.c"
+#include "bitsetMethods.c"
+
+#define MAX_ARGS       8
+#define ERROR_ARGS     1
+#define ERROR_FILE     4
+#define ERROR_RAM      5
+#define ERROR_INPUT    6
+#define HUB_DIVISOR    10
+#define MAX_ATTEMPTS   100
+
+/**
+ * returns next pseudo random number of the xorshift64* generator of state
+ * the sequence only depends on the seed, so workloads are reproducible on
+ * all platforms
+ */
+uint64_t nextRandom(uint64_t* state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+/**
+ * returns pseudo random number in [0, 1)
+ */
+double nextUniform(uint64_t* state)
+{
+    return (nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * draws cardinality from min_card to max_card with weights
+ * decay^(card - min_card) given as cumulative weights
+ */
+int drawCardinality(uint64_t* state, double* cumulative, int min_card, int
+        max_card)
+{
+    double r = nextUniform(state) * cumulative[max_card - min_card];
+    int    c;
+    for (c = 0; c < max_card - min_card; c++)
+    {
+        if (r < cumulative[c])
+        {
+            break;
+        }
+    }
+    return min_card + c;
+}
+
+/**
+ * draws card different reactions into row
+ *   - with probability overlap a reaction is drawn from the hub reactions,
+ *     the first hub_count reactions, otherwise from all reactions
+ *   - higher overlap lets more rows share reactions
+ */
+void drawReactions(uint64_t* state, bitword* row, int word_count, int
+        rx_count, int hub_count, double overlap, int card)
+{
+    memset(row, 0, word_count * sizeof(bitword));
+    int drawn = 0;
+    while (drawn < card)
+    {
+        int range = nextUniform(state) < overlap ? hub_count : rx_count;
+        int rx    = nextRandom(state) % range;
+        if (!WORDTEST(row, rx))
+        {
+            WORDSET(row, rx);
+            drawn++;
+        }
+    }
+}
+
+/**
+ * returns hash of row
+ */
+uint64_t hashRow(bitword* row, int word_count)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    int w;
+    for (w = 0; w < word_count; w++)
+    {
+        hash = (hash ^ row[w]) * 1099511628211ULL;
+        hash ^= hash >> 29;
+    }
+    return hash ? hash : 1;
+}
+
+/**
+ * inserts hash into open addressing set of size slots
+ * returns 0 if the hash was already in the set
+ */
+int insertHash(uint64_t* set, unsigned long size, uint64_t hash)
+{
+    unsigned long slot = hash & (size - 1);
+    while (set[slot])
+    {
+        if (set[slot] == hash)
+        {
+            return 0;
+        }
+        slot = (slot + 1) & (size - 1);
+    }
+    set[slot] = hash;
+    return 1;
+}
+
+int main (int argc, char *argv[])
+{
+    // read arguments
+    char *optv[MAX_ARGS] = { "-k", "-r", "-n", "-c", "-q", "-h", "-s", "-o" };
+    char *optd[MAX_ARGS] = { "kind of workload: mcs or efm [default=mcs]", 
+        "number of reactions",
+        "number of mcs or efms",
+        "range of cardinalities as min-max [default=2-6]",
+        "decay of the cardinality distribution, cardinality c has weight \
+decay^(c - min), 1 is uniform [default=0.5]",
+        "overlap density: probability to draw a reaction from the hub \
+reactions, the first tenth of all reactions [default=0.3]",
+        "seed of the random generator [default=1]",
+        "output file"};
+    char *optr[MAX_ARGS];
+    char *description = "Generate a synthetic mcs or efm file with controlled \
+size, cardinalities and overlap";
+    char *usg = "generateWorkload -k mcs -r 300 -n 50000 -c 2-6 -q 0.5 -h 0.3 \
+-o bench.cutsets";
+
+    readArgs(argc, argv, MAX_ARGS, optv, optr);
+
+    // check if compulsory arguments are given
+    if ( (!optr[1]) || (!optr[2]) || (!optr[7]) )
+    {
+        usage(description, usg, MAX_ARGS, optv, optd);
+        quitError("Missing argument\n", ERROR_ARGS);
+    }
+
+    int is_efm = 0;
+    if (optr[0])
+    {
+        if (!strcmp(optr[0], "efm"))
+        {
+            is_efm = 1;
+        }
+        else if (strcmp(optr[0], "mcs"))
+        {
+            quitError("Kind of workload needs to be mcs or efm\n\n",
+                    ERROR_ARGS);
+        }
+    }
+    int           rx_count  = atoi(optr[1]);
+    unsigned long row_count = strtoul(optr[2], NULL, 10);
+    int           min_card  = 2;
+    int           max_card  = 6;
+    if (optr[3] && (sscanf(optr[3], "%d-%d", &min_card, &max_card) != 2))
+    {
+        quitError("Range of cardinalities needs to be given as min-max\n\n",
+                ERROR_ARGS);
+    }
+    double   decay   = optr[4] ? atof(optr[4]) : 0.5;
+    double   overlap = optr[5] ? atof(optr[5]) : 0.3;
+    uint64_t state   = optr[6] ? strtoull(optr[6], NULL, 10) : 1;
+    if ( (rx_count < 1) || (row_count < 1) )
+    {
+        quitError("Number of reactions and rows need to be > 0\n\n",
+                ERROR_ARGS);
+    }
+    // mcs of one reaction are single knockouts, failureProbabilityByMcs
+    // removes the mcs containing them while loading
+    if ( (min_card < 1) || (max_card < min_card) ||
+         (max_card > rx_count) )
+    {
+        quitError("Range of cardinalities is not valid\n\n", ERROR_ARGS);
+    }
+    if ( (decay <= 0) || (overlap < 0) || (overlap > 1) )
+    {
+        quitError("Decay needs to be > 0 and overlap in [0, 1]\n\n",
+                ERROR_ARGS);
+    }
+    state = (state + 1) * 0x9E3779B97F4A7C15ULL;
+    if (0 == state)
+    {
+        state = 1;
+    }
+
+    FILE *file_out = fopen(optr[7], "w");
+    if (!file_out)
+    {
+        quitError("Error in opening outputfile\n", ERROR_FILE);
+    }
+
+    // cumulative weights of cardinalities
+    double* cumulative = malloc((max_card - min_card + 1) * sizeof(double));
+    if (NULL == cumulative)
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+    double weight = 1;
+    double sum    = 0;
+    int    c;
+    for (c = 0; c <= max_card - min_card; c++)
+    {
+        sum          += weight;
+        cumulative[c] = sum;
+        weight       *= decay;
+    }
+
+    // hub reactions are shared by many rows
+    int hub_count = rx_count / HUB_DIVISOR;
+    if (hub_count < max_card)
+    {
+        hub_count = max_card;
+    }
+
+    // mcs are written unique, rows are identified by their hash
+    int           word_count = getWordCount(rx_count);
+    bitword*      row        = malloc(word_count * sizeof(bitword));
+    char*         line       = malloc(is_efm ? 16 * rx_count + 1 : rx_count +
+            2);
+    unsigned long set_size   = 1;
+    while (set_size < 2 * row_count)
+    {
+        set_size <<= 1;
+    }
+    uint64_t* set = is_efm ? NULL : calloc(set_size, sizeof(uint64_t));
+    if ( (NULL == row) || (NULL == line) || (!is_efm && (NULL == set)) )
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+
+    unsigned long written  = 0;
+    unsigned long attempts = 0;
+    while (written < row_count)
+    {
+        if (++attempts > MAX_ATTEMPTS * row_count)
+        {
+            quitError("Not enough different mcs for these reactions and \
+cardinalities\n", ERROR_INPUT);
+        }
+        int card = drawCardinality(&state, cumulative, min_card, max_card);
+        drawReactions(&state, row, word_count, rx_count, hub_count, overlap,
+                card);
+        size_t len = 0;
+        int    rx;
+        if (is_efm)
+        {
+            // efms are tab separated fluxes of all reactions
+            for (rx = 0; rx < rx_count; rx++)
+            {
+                if (WORDTEST(row, rx))
+                {
+                    // fluxes keep a distance to 0 to stay nonzero in text
+                    double flux = 0.01 + 2 * nextUniform(&state);
+                    if (nextRandom(&state) & 1)
+                    {
+                        flux = -flux;
+                    }
+                    len += sprintf(line + len, "%.10f", flux);
+                }
+                else
+                {
+                    line[len++] = '0';
+                }
+                line[len++] = rx + 1 < rx_count ? '\t' : '\n';
+            }
+        }
+        else
+        {
+            if (!insertHash(set, set_size, hashRow(row, word_count)))
+            {
+                continue;
+            }
+            for (rx = 0; rx < rx_count; rx++)
+            {
+                line[len++] = WORDTEST(row, rx) ? '1' : '0';
+            }
+            line[len++] = '\n';
+        }
+        fwrite(line, 1, len, file_out);
+        written++;
+    }
+
+    fclose(file_out);
+    free(cumulative);
+    free(row);
+    free(line);
+    free(set);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// inverted index of a reduced mcs matrix
+// the ids of all mcs containing reaction rx are stored in ascending order
+// in ids[offsets[rx]] ... ids[offsets[rx + 1] - 1]
+struct mcs_index
+{
+    int            rx_count;
+    unsigned long* offsets;
+    uint32_t*      ids;
+};
+
+int initMcsIndex(struct mcs_index* index, bitword* mat, unsigned long
+        mcs_count, int rx_count, int word_count);
+void freeMcsIndex(struct mcs_index* index);
+unsigned long countMcsIndexBefore(struct mcs_index* index, int rx, unsigned
+        long mcs_id);
+void markMcsIndex(struct mcs_index* index, int rx, unsigned long mcs_id,
+        bitword* marks);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initMcsIndex
+ *  Description:  builds the inverted index of the mcs_count rows of the slab
+ *                mat with word_count words per row
+ *                returns 0 if there is not enough free memory or the mcs ids
+ *                do not fit in 32 bit
+ * =====================================================================================
+ */
+    int
+initMcsIndex(struct mcs_index* index, bitword* mat, unsigned long mcs_count,
+        int rx_count, int word_count)
+{
+    index->rx_count = rx_count;
+    index->offsets  = calloc(rx_count + 1, sizeof(unsigned long));
+    index->ids      = NULL;
+    if ( (NULL == index->offsets) || (mcs_count > UINT32_MAX) )
+    {
+        freeMcsIndex(index);
+        return 0;
+    }
+
+    // count mcs of each reaction, offsets[rx + 1] holds the count of rx
+    unsigned long li;
+    int           w;
+    for (li = 0; li < mcs_count; li++)
+    {
+        bitword* row = SLABROW(mat, li, word_count);
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                index->offsets[w * WORDBITS + __builtin_ctzll(bits) + 1]++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    int rx;
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        index->offsets[rx + 1] += index->offsets[rx];
+    }
+
+    // fill posting lists in ascending order of mcs ids
+    index->ids = malloc((index->offsets[rx_count] + 1) * sizeof(uint32_t));
+    unsigned long* next = malloc((rx_count + 1) * sizeof(unsigned long));
+    if ( (NULL == index->ids) || (NULL == next) )
+    {
+        free(next);
+        freeMcsIndex(index);
+        return 0;
+    }
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        next[rx] = index->offsets[rx];
+    }
+    for (li = 0; li < mcs_count; li++)
+    {
+        bitword* row = SLABROW(mat, li, word_count);
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                index->ids[next[w * WORDBITS + __builtin_ctzll(bits)]++] = li;
+                bits &= bits - 1;
+            }
+        }
+    }
+    free(next);
+    return 1;
+}		/* -----  end of function initMcsIndex  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeMcsIndex
+ *  Description:  frees memory of an inverted index
+ * =====================================================================================
+ */
+    void
+freeMcsIndex(struct mcs_index* index)
+{
+    free(index->offsets);
+    free(index->ids);
+    index->offsets = NULL;
+    index->ids     = NULL;
+}		/* -----  end of function freeMcsIndex  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  countMcsIndexBefore
+ *  Description:  returns number of mcs with id < mcs_id containing reaction rx
+ * =====================================================================================
+ */
+    unsigned long
+countMcsIndexBefore(struct mcs_index* index, int rx, unsigned long mcs_id)
+{
+    unsigned long low  = index->offsets[rx];
+    unsigned long high = index->offsets[rx + 1];
+    while (low < high)
+    {
+        unsigned long mid = low + (high - low) / 2;
+        if (index->ids[mid] < mcs_id)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low - index->offsets[rx];
+}		/* -----  end of function countMcsIndexBefore  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  markMcsIndex
+ *  Description:  sets the bits of all mcs with id < mcs_id containing
+ *                reaction rx in marks
+ * =====================================================================================
+ */
+    void
+markMcsIndex(struct mcs_index* index, int rx, unsigned long mcs_id, bitword*
+        marks)
+{
+    unsigned long i   = index->offsets[rx];
+    unsigned long end = index->offsets[rx + 1];
+    for (; (i < end) && (index->ids[i] < mcs_id); i++)
+    {
+        WORDSET(marks, index->ids[i]);
+    }
+}		/* -----  end of function markMcsIndex  ----- */
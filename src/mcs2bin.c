@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "generalFunctions.c"
+#include "bitsetMethods.c"
+#include "trieMethods.c"
+#include "mcsMethods.c"
+
+#define MAX_ARGS       4
+#define ERROR_ARGS     1
+#define ERROR_THREADS  2
+#define ERROR_FILE     4
+#define ERROR_RAM      5
+#define ERROR_INPUT    6
+
+/**
+ * read reaction names, one name per line
+ * stores names separated by '\0' in names and returns number of names
+ */
+int readReactionNames(char* filename, char** m_names, size_t* m_names_size)
+{
+    FILE* file = fopen(filename, "r");
+    if (!file)
+    {
+        quitError("Error in opening file of reaction names\n", ERROR_FILE);
+    }
+    char*  names      = NULL;
+    size_t names_size = 0;
+    char*  line       = NULL;
+    size_t len        = 0;
+    int    count      = 0;
+    ssize_t line_len;
+    while ( (line_len = getline(&line, &len, file)) != -1)
+    {
+        while ( (line_len > 0) && ((line[line_len - 1] == '\n') ||
+                    (line[line_len - 1] == '\r')) )
+        {
+            line_len--;
+        }
+        names = realloc(names, names_size + line_len + 1);
+        if (NULL == names)
+        {
+            quitError("Not enough free memory for reaction names\n",
+                    ERROR_RAM);
+        }
+        memcpy(names + names_size, line, line_len);
+        names[names_size + line_len] = '\0';
+        names_size += line_len + 1;
+        count++;
+    }
+    free(line);
+    fclose(file);
+    *m_names      = names;
+    *m_names_size = names_size;
+    return count;
+}
+
+int main (int argc, char *argv[])
+{
+    // read arguments
+    char *optv[MAX_ARGS] = { "-i", "-o", "-n", "-t" };
+    char *optd[MAX_ARGS] = { "mcs file in form of 000110", 
+        "output file (binary mcs file)",
+        "file with reaction names, one name per line [optional]",
+        "number of threads [default=1]"};
+    char *optr[MAX_ARGS];
+    char *description = "Convert mcs file to binary format read by \
+                         failureProbabilityByMcs";
+    char *usg = "mcs2bin -i mcs.csv -o mcs.bin -n reactions.txt -t 6";
+
+    readArgs(argc, argv, MAX_ARGS, optv, optr);
+
+    // check if compulsory arguments are given
+    if ( (!optr[0]) || (!optr[1]) )
+    {
+        usage(description, usg, MAX_ARGS, optv, optd);
+        quitError("Missing argument\n", ERROR_ARGS);
+    }
+
+    // define number of threads to use
+    int max_threads = 1;
+    if (optr[3])
+    {
+        max_threads = atoi(optr[3]);
+    }
+    if (max_threads < 1)
+    {
+        quitError("Number of threads < 1\n\n", ERROR_THREADS);
+    }
+
+    // map mcs file into memory
+    struct mcs_file mcs_file;
+    if (!openMcsFile(optr[0], &mcs_file))
+    {
+        quitError("Error in opening file\n", ERROR_FILE);
+    }
+    if (!isValidMcsFile(&mcs_file) || mcs_file.is_binary)
+    {
+        quitError("MCS file is not valid\n", ERROR_FILE);
+    }
+    int rx_count = mcs_file.rx_count;
+
+    // read reaction names
+    char*  names      = NULL;
+    size_t names_size = 0;
+    if (optr[2])
+    {
+        if (readReactionNames(optr[2], &names, &names_size) != rx_count)
+        {
+            quitError("Number of reaction names differs from number of \
+reactions\n", ERROR_INPUT);
+        }
+    }
+
+    // read mcs matrix
+    int            word_count   = getWordCount(rx_count);
+    bitword*       initial_mat  = NULL;
+    int*           mcs_card     = NULL;
+    unsigned long  mcs_count    = 0;
+    unsigned long* mcs_card_sum = calloc(rx_count, sizeof(unsigned long));
+    if (NULL == mcs_card_sum)
+    {
+        quitError("Not enough free memory for mcs_card_sum\n", ERROR_RAM);
+    }
+    int read_status = readMcsFile(&mcs_file, max_threads, &mcs_count,
+            &initial_mat, &mcs_card, mcs_card_sum);
+    if (MCS_ERROR_RAM == read_status)
+    {
+        quitError("Not enough free memory for mcs matrix\n", ERROR_RAM);
+    }
+    if (MCS_OK != read_status)
+    {
+        quitError("MCS file is not valid\n", ERROR_INPUT);
+    }
+    closeMcsFile(&mcs_file);
+
+    // remove duplicate and non-minimal mcs
+    unsigned long duplicate_count;
+    unsigned long superset_count;
+    if (MCS_OK != filterMcsRows(initial_mat, mcs_card, mcs_card_sum,
+                &mcs_count, rx_count, &duplicate_count, &superset_count))
+    {
+        quitError("Not enough free memory for filtering mcs\n", ERROR_RAM);
+    }
+
+    // reduce matrix of all cardinalities
+    int           red_rx_count   = rx_count - mcs_card_sum[0];
+    int           red_word_count = getWordCount(red_rx_count);
+    unsigned long red_mcs_count  = mcs_count - mcs_card_sum[0];
+    bitword*      reduced_mat    = newBitsetSlab(red_mcs_count,
+            red_word_count);
+    int*          left_cols      = malloc((red_rx_count + 1) * sizeof(int));
+    if ( (NULL == reduced_mat) || (NULL == left_cols) || (MCS_OK !=
+                processMatrix(rx_count, mcs_count, initial_mat, mcs_card,
+                    mcs_card_sum, word_count, red_rx_count, reduced_mat,
+                    red_word_count, rx_count, left_cols)) )
+    {
+        quitError("Not enough free memory for reduced matrix\n", ERROR_RAM);
+    }
+    free(initial_mat);
+
+    // write binary file
+    FILE *file_out = fopen(optr[1], "wb");
+    if (!file_out)
+    {
+        quitError("Error in opening outputfile\n", ERROR_FILE);
+    }
+    if ( (MCS_OK != writeMcsBinary(file_out, rx_count, mcs_count,
+                    mcs_card_sum, red_rx_count, red_mcs_count, reduced_mat,
+                    left_cols, names, names_size)) || fclose(file_out) )
+    {
+        quitError("Error in writing outputfile\n", ERROR_FILE);
+    }
+
+    printf("reactions:              %d\n", rx_count);
+    printf("mcs:                    %lu\n", mcs_count);
+    printf("duplicates removed:     %lu\n", duplicate_count);
+    printf("supersets removed:      %lu\n", superset_count);
+    printf("single knockouts:       %lu\n", mcs_card_sum[0]);
+    printf("words per reduced mcs:  %d\n", red_word_count);
+
+    // free memory
+    free(reduced_mat);
+    free(left_cols);
+    free(names);
+    free(mcs_card);
+    free(mcs_card_sum);
+
+    return EXIT_SUCCESS;
+}
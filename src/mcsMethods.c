@@ -0,0 +1,1227 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MCS_OK           0
+#define MCS_ERROR_FILE   1
+#define MCS_ERROR_RAM    2
+#define MCS_ERROR_FORMAT 3
+
+#define MCS_BIN_MAGIC    "NRTMCSB"
+#define MCS_BIN_VERSION  1
+#define MCS_BIN_ALIGN    64
+
+// rows compared by compareMcsRows and frequencies compared by
+// compareReactionFreq
+static bitword*       compareMat       = NULL;
+static int            compareWordCount = 0;
+static unsigned long* compareFreq      = NULL;
+
+// header of binary mcs files, all numbers in byte order of the machine
+// the header is followed by
+//   - uint64_t card_sum[rx_count]: number of mcs with cardinality i + 1
+//   - uint32_t left_cols[red_rx_count]: original column of reduced columns
+//   - char names[names_size]: '\0' terminated reaction names (optional)
+//   - rows of reduced mcs starting at rows_offset (multiple of 64), sorted
+//     by cardinality, each of word_count 64 bit words
+// reduced mcs are all mcs except single knockouts without the columns of
+// single knockouts
+struct mcs_bin_header
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t word_bits;
+    uint64_t rx_count;
+    uint64_t red_rx_count;
+    uint64_t mcs_count;
+    uint64_t row_count;
+    uint64_t word_count;
+    uint64_t names_size;
+    uint64_t rows_offset;
+};
+
+// memory mapped mcs file consisting of lines like 0001100 or binary mcs
+// file written by mcs2bin
+struct mcs_file
+{
+    char*           data;
+    size_t          size;
+    int             rx_count;
+    int             is_binary;
+    int             red_rx_count;
+    unsigned long   mcs_count;
+    unsigned long   row_count;
+    const uint64_t* card_sum;
+    const uint32_t* left_cols;
+    const char*     names;
+    size_t          names_size;
+    bitword*        rows;
+};
+
+// line aligned part of an mcs file parsed by one thread
+struct mcs_chunk
+{
+    const char*    begin;
+    const char*    end;
+    unsigned long  first_row;
+    unsigned long  rows;
+    int            rx_count;
+    int            word_count;
+    bitword*       mat;
+    int*           mcs_card;
+    unsigned long* card_sum;
+    int            status;
+};
+
+int openMcsFile(char* filename, struct mcs_file* file);
+int readMcsBinaryHeader(struct mcs_file* file);
+int writeMcsBinary(FILE* out, int rx_count, unsigned long mcs_count, unsigned
+        long* mcs_card_sum, int red_rx_count, unsigned long red_mcs_count,
+        bitword* red_mat, int* left_cols, char* names, size_t names_size);
+void closeMcsFile(struct mcs_file* file);
+int isValidMcsFile(struct mcs_file* file);
+int readMcsFile(struct mcs_file* file, int max_threads, unsigned long*
+        mcs_count, bitword** m_mat, int** m_mcs_card, unsigned long*
+        mcs_card_sum);
+int processMatrix(int rx_count, unsigned long mcs_count, bitword* initial_mat,
+        int* mcs_card, unsigned long* mcs_card_sum, int word_count, int
+        red_rx_count, bitword* red_mat, int red_word_count, int max_card,
+        int* left_cols);
+int filterMcsRows(bitword* mat, int* mcs_card, unsigned long* mcs_card_sum,
+        unsigned long* mcs_count, int rx_count, unsigned long*
+        duplicate_count, unsigned long* superset_count);
+uint64_t hashMcsRowKey(uint64_t li);
+int compareMcsRows(const void* a, const void* b);
+int compareReactionFreq(const void* a, const void* b);
+int reorderMatrix(bitword* red_mat, unsigned long red_mcs_count, int
+        red_rx_count, int order_columns, int order_rows, bitword** ord_mat);
+int compressMatrix(bitword* red_mat, unsigned long red_mcs_count, int
+        red_rx_count, bitword** comp_mat, int* comp_rx_count, int*
+        rx_weights);
+void *countMcsLines(void *pointer_chunk);
+void *parseMcsLines(void *pointer_chunk);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  openMcsFile
+ *  Description:  maps an mcs file into memory and defines number of reactions
+ *                by the length of the first line
+ *                returns 0 if the file cannot be opened
+ * =====================================================================================
+ */
+    int
+openMcsFile(char* filename, struct mcs_file* file)
+{
+    memset(file, 0, sizeof(struct mcs_file));
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return 0;
+    }
+    if (st.st_size > 0)
+    {
+        file->size = st.st_size;
+        file->data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == file->data)
+        {
+            file->data = NULL;
+            close(fd);
+            return 0;
+        }
+        if ( (file->size >= sizeof(struct mcs_bin_header)) &&
+                !memcmp(file->data, MCS_BIN_MAGIC, sizeof(MCS_BIN_MAGIC)) )
+        {
+            // rx_count stays 0 for inconsistent headers
+            file->is_binary = 1;
+            readMcsBinaryHeader(file);
+        }
+        else
+        {
+            madvise(file->data, file->size, MADV_SEQUENTIAL);
+            char* eol = memchr(file->data, '\n', file->size);
+            file->rx_count = eol ? (size_t)(eol - file->data) : file->size;
+        }
+    }
+    close(fd);
+    return 1;
+}		/* -----  end of function openMcsFile  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  readMcsBinaryHeader
+ *  Description:  sets pointers to the parts of a mapped binary mcs file
+ *                returns 0 if the header does not match the file
+ * =====================================================================================
+ */
+    int
+readMcsBinaryHeader(struct mcs_file* file)
+{
+    struct mcs_bin_header header;
+    memcpy(&header, file->data, sizeof(struct mcs_bin_header));
+    size_t tables_size = header.rx_count * sizeof(uint64_t) +
+        header.red_rx_count * sizeof(uint32_t) + header.names_size;
+    if ( (header.version != MCS_BIN_VERSION) || 
+         (header.word_bits != WORDBITS) || 
+         (header.rx_count < 1) || (header.rx_count > INT_MAX) ||
+         (header.red_rx_count > header.rx_count) ||
+         (header.word_count != (uint64_t)getWordCount(header.red_rx_count)) ||
+         (header.rows_offset % MCS_BIN_ALIGN != 0) ||
+         (header.rows_offset < sizeof(struct mcs_bin_header) + tables_size) ||
+         (header.rows_offset > file->size) ||
+         (header.word_count > 0 && (file->size - header.rows_offset) /
+            (header.word_count * sizeof(bitword)) < header.row_count) )
+    {
+        return 0;
+    }
+    const char* tables  = file->data + sizeof(struct mcs_bin_header);
+    file->red_rx_count  = header.red_rx_count;
+    file->mcs_count     = header.mcs_count;
+    file->row_count     = header.row_count;
+    file->card_sum      = (const uint64_t*) tables;
+    file->left_cols     = (const uint32_t*) (tables + header.rx_count *
+            sizeof(uint64_t));
+    file->names         = (const char*) (file->left_cols +
+            header.red_rx_count);
+    file->names_size    = header.names_size;
+    file->rows          = (bitword*) (file->data + header.rows_offset);
+    file->rx_count      = header.rx_count;
+    return 1;
+}		/* -----  end of function readMcsBinaryHeader  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeMcsBinary
+ *  Description:  writes reduced mcs matrix of processMatrix as binary mcs
+ *                file
+ *                returns MCS_OK or MCS_ERROR_FILE
+ * =====================================================================================
+ */
+    int
+writeMcsBinary(FILE* out, int rx_count, unsigned long mcs_count, unsigned
+        long* mcs_card_sum, int red_rx_count, unsigned long red_mcs_count,
+        bitword* red_mat, int* left_cols, char* names, size_t names_size)
+{
+    struct mcs_bin_header header;
+    memset(&header, 0, sizeof(struct mcs_bin_header));
+    memcpy(header.magic, MCS_BIN_MAGIC, sizeof(MCS_BIN_MAGIC));
+    header.version      = MCS_BIN_VERSION;
+    header.word_bits    = WORDBITS;
+    header.rx_count     = rx_count;
+    header.red_rx_count = red_rx_count;
+    header.mcs_count    = mcs_count;
+    header.row_count    = red_mcs_count;
+    header.word_count   = getWordCount(red_rx_count);
+    header.names_size   = names_size;
+    size_t offset = sizeof(struct mcs_bin_header) + rx_count *
+        sizeof(uint64_t) + red_rx_count * sizeof(uint32_t) + names_size;
+    header.rows_offset  = (offset + MCS_BIN_ALIGN - 1) / MCS_BIN_ALIGN *
+        MCS_BIN_ALIGN;
+
+    int ok = fwrite(&header, sizeof(struct mcs_bin_header), 1, out) == 1;
+    int i;
+    for (i = 0; i < rx_count; i++)
+    {
+        uint64_t sum = mcs_card_sum[i];
+        ok = ok && fwrite(&sum, sizeof(uint64_t), 1, out) == 1;
+    }
+    for (i = 0; i < red_rx_count; i++)
+    {
+        uint32_t col = left_cols[i];
+        ok = ok && fwrite(&col, sizeof(uint32_t), 1, out) == 1;
+    }
+    if (names_size > 0)
+    {
+        ok = ok && fwrite(names, 1, names_size, out) == names_size;
+    }
+    for (; offset < header.rows_offset; offset++)
+    {
+        ok = ok && fputc(0, out) != EOF;
+    }
+    ok = ok && fwrite(red_mat, sizeof(bitword) * header.word_count,
+            red_mcs_count, out) == red_mcs_count;
+    return ok ? MCS_OK : MCS_ERROR_FILE;
+}		/* -----  end of function writeMcsBinary  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  closeMcsFile
+ *  Description:  unmaps an mcs file
+ * =====================================================================================
+ */
+    void
+closeMcsFile(struct mcs_file* file)
+{
+    if (file->data)
+    {
+        munmap(file->data, file->size);
+    }
+    file->data = NULL;
+    file->size = 0;
+}		/* -----  end of function closeMcsFile  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  isValidMcsFile
+ *  Description:  returns 1 if the first line consists of 0 and 1 only
+ *                or if the header of a binary file is consistent
+ * =====================================================================================
+ */
+    int
+isValidMcsFile(struct mcs_file* file)
+{
+    if (file->rx_count < 1)
+    {
+        return 0;
+    }
+    if (file->is_binary)
+    {
+        return 1;
+    }
+    int i;
+    for (i = 0; i < file->rx_count; i++)
+    {
+        if ( (file->data[i] != '0') && (file->data[i] != '1') )
+        {
+            return 0;
+        }
+    }
+    return 1;
+}		/* -----  end of function isValidMcsFile  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  countMcsLines
+ *  Description:  thread function counting the lines of a chunk
+ * =====================================================================================
+ */
+    void *
+countMcsLines(void *pointer_chunk)
+{
+    struct mcs_chunk* chunk = (struct mcs_chunk*) pointer_chunk;
+    const char*       pos   = chunk->begin;
+    chunk->rows = 0;
+    while (pos < chunk->end)
+    {
+        const char* eol = memchr(pos, '\n', chunk->end - pos);
+        chunk->rows++;
+        if (!eol)
+        {
+            break;
+        }
+        pos = eol + 1;
+    }
+    return((void *)NULL);
+}		/* -----  end of function countMcsLines  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  parseMcsLines
+ *  Description:  thread function storing the lines of a chunk in its rows of
+ *                the bit matrix and counting the cardinalities
+ * =====================================================================================
+ */
+    void *
+parseMcsLines(void *pointer_chunk)
+{
+    struct mcs_chunk* chunk      = (struct mcs_chunk*) pointer_chunk;
+    const char*       pos        = chunk->begin;
+    int               rx_count   = chunk->rx_count;
+    int               word_count = chunk->word_count;
+    unsigned long     row        = chunk->first_row;
+    chunk->status = MCS_OK;
+    while (pos < chunk->end)
+    {
+        const char* eol = memchr(pos, '\n', chunk->end - pos);
+        if (!eol)
+        {
+            eol = chunk->end;
+        }
+        if (eol - pos != rx_count)
+        {
+            chunk->status = MCS_ERROR_FORMAT;
+            return((void *)NULL);
+        }
+
+        // build each word of the row from 64 characters
+        bitword* mcs  = chunk->mat + row * word_count;
+        int      card = 0;
+        int      w;
+        for (w = 0; w < word_count; w++)
+        {
+            const char* chars = pos + w * WORDBITS;
+            int         len   = rx_count - w * WORDBITS;
+            bitword     word  = 0;
+            int         j;
+            if (len > WORDBITS)
+            {
+                len = WORDBITS;
+            }
+            for (j = 0; j < len; j++)
+            {
+                word |= (bitword)(chars[j] == '1') << j;
+                if ( (chars[j] != '0') && (chars[j] != '1') )
+                {
+                    chunk->status = MCS_ERROR_FORMAT;
+                    return((void *)NULL);
+                }
+            }
+            mcs[w] = word;
+            card  += __builtin_popcountll(word);
+        }
+        if (card == 0)
+        {
+            chunk->status = MCS_ERROR_FORMAT;
+            return((void *)NULL);
+        }
+        chunk->mcs_card[row] = card - 1;
+        chunk->card_sum[card - 1]++;
+        row++;
+        pos = eol + 1;
+    }
+    return((void *)NULL);
+}		/* -----  end of function parseMcsLines  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  readMcsFile
+ *  Description:  parses a mapped mcs file with max_threads threads into a
+ *                contiguous bit matrix with one row of getWordCount(rx_count)
+ *                words per mcs
+ *                defines cardinality - 1 for each mcs and counts mcs per
+ *                cardinality in mcs_card_sum
+ *                returns MCS_OK or an error code
+ * =====================================================================================
+ */
+    int
+readMcsFile(struct mcs_file* file, int max_threads, unsigned long*
+        mcs_count, bitword** m_mat, int** m_mcs_card, unsigned long*
+        mcs_card_sum)
+{
+    int rx_count   = file->rx_count;
+    int word_count = getWordCount(rx_count);
+    int status     = MCS_OK;
+    int i, j;
+
+    // split file into line aligned chunks
+    struct mcs_chunk* chunk  = calloc(max_threads, sizeof(struct mcs_chunk));
+    pthread_t*        thread = malloc(max_threads * sizeof(pthread_t));
+    if ( (NULL == chunk) || (NULL == thread) )
+    {
+        return MCS_ERROR_RAM;
+    }
+    const char* begin = file->data;
+    const char* end   = file->data + file->size;
+    for (i = 0; i < max_threads; i++)
+    {
+        const char* chunk_end = file->data + file->size / max_threads * (i +
+                1);
+        if (i == max_threads - 1)
+        {
+            chunk_end = end;
+        }
+        else if (chunk_end <= begin)
+        {
+            chunk_end = begin;
+        }
+        else
+        {
+            // move end behind the next newline, unless it starts a line
+            const char* eol = memchr(chunk_end - 1, '\n', end - chunk_end +
+                    1);
+            chunk_end = eol ? eol + 1 : end;
+        }
+        chunk[i].begin      = begin;
+        chunk[i].end        = chunk_end;
+        chunk[i].rx_count   = rx_count;
+        chunk[i].word_count = word_count;
+        begin = chunk_end;
+    }
+
+    // count lines to define first row of each chunk
+    for (i = 0; i < max_threads; i++)
+    {
+        pthread_create(&thread[i], NULL, countMcsLines, (void *)&chunk[i]);
+    }
+    unsigned long rows = 0;
+    for (i = 0; i < max_threads; i++)
+    {
+        pthread_join(thread[i], NULL);
+        chunk[i].first_row = rows;
+        rows += chunk[i].rows;
+    }
+
+    // parse lines directly into the matrix
+    bitword* mat      = calloc(rows * word_count + 1, sizeof(bitword));
+    int*     mcs_card = malloc((rows + 1) * sizeof(int));
+    if ( (NULL == mat) || (NULL == mcs_card) )
+    {
+        status = MCS_ERROR_RAM;
+    }
+    for (i = 0; (i < max_threads) && (MCS_OK == status); i++)
+    {
+        chunk[i].mat      = mat;
+        chunk[i].mcs_card = mcs_card;
+        chunk[i].card_sum = calloc(rx_count, sizeof(unsigned long));
+        if (NULL == chunk[i].card_sum)
+        {
+            status = MCS_ERROR_RAM;
+        }
+    }
+    if (MCS_OK == status)
+    {
+        for (i = 0; i < max_threads; i++)
+        {
+            pthread_create(&thread[i], NULL, parseMcsLines,
+                    (void *)&chunk[i]);
+        }
+        for (i = 0; i < max_threads; i++)
+        {
+            pthread_join(thread[i], NULL);
+        }
+    }
+
+    // merge cardinalities of all chunks
+    for (j = 0; j < rx_count; j++)
+    {
+        mcs_card_sum[j] = 0;
+    }
+    for (i = 0; i < max_threads; i++)
+    {
+        if (MCS_OK == status)
+        {
+            status = chunk[i].status;
+        }
+        if (chunk[i].card_sum)
+        {
+            for (j = 0; j < rx_count; j++)
+            {
+                mcs_card_sum[j] += chunk[i].card_sum[j];
+            }
+            free(chunk[i].card_sum);
+        }
+    }
+    free(chunk);
+    free(thread);
+    if (MCS_OK != status)
+    {
+        free(mat);
+        free(mcs_card);
+        return status;
+    }
+
+    *mcs_count  = rows;
+    *m_mat      = mat;
+    *m_mcs_card = mcs_card;
+    return MCS_OK;
+}		/* -----  end of function readMcsFile  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  processMatrix
+ *  Description:  remove single knockouts from matrix
+ *                  - remove rows with single knockouts
+ *                  - remove columns where single knockouts == 1
+ *                remove knockouts from matrix with higher cardinality than
+ *                max_card and sort the left mcs by cardinality into the zeroed
+ *                slab red_mat
+ *                stores original column of each reduced column in left_cols
+ *                returns MCS_OK or MCS_ERROR_RAM
+ * =====================================================================================
+ */
+    int
+processMatrix(int rx_count, unsigned long mcs_count, bitword* initial_mat,
+        int* mcs_card, unsigned long* mcs_card_sum, int word_count, int
+        red_rx_count, bitword* red_mat, int red_word_count, int max_card,
+        int* left_cols)
+{
+    // remove single knockouts
+    if (mcs_card_sum[0] > 0)
+    {
+        // define bitset for single knockouts
+        bitword* single_ko_cols = calloc(word_count, sizeof(bitword));
+        if (NULL == single_ko_cols)
+        {
+            return MCS_ERROR_RAM;
+        }
+
+        // find reactions of single knockouts
+        unsigned long li = 0;
+        for (li = 0; li < mcs_count; li++)
+        {
+            if (mcs_card[li] == 0)
+            {
+                bitsetOr(single_ko_cols, single_ko_cols, initial_mat + li *
+                        word_count, word_count);
+            }
+        }
+
+        // define columns that are not used by single knockouts
+        int i = 0;
+        int j = 0;
+        for (i = 0; i < rx_count; i++){
+            if (!(WORDTEST(single_ko_cols, i))){
+                left_cols[j] = i;
+                j++;
+            }
+        }
+        free(single_ko_cols);
+        single_ko_cols = NULL;
+    } 
+    else 
+    {
+        // no single knockout, set left columns to all columns
+        int i = 0;
+        for (i = 0; i < red_rx_count; i++)
+        {
+            left_cols[i] = i;
+        }
+    }
+
+    // reduce matrix into the slab red_mat, rows sorted by cardinality
+    unsigned long* next_row = malloc(max_card * sizeof(unsigned long));
+    if (NULL == next_row)
+    {
+        return MCS_ERROR_RAM;
+    }
+    int           i  = 0;
+    unsigned long li = 0;
+    next_row[0] = 0;
+    for (i = 1; i < max_card; i++)
+    {
+        next_row[i] = li;
+        li += mcs_card_sum[i];
+    }
+    unsigned long mcs_ix = 0;
+    for (mcs_ix = 0; mcs_ix < mcs_count; mcs_ix++)
+    {
+        int card = mcs_card[mcs_ix];
+        if ( (card > 0) && (card < max_card) )
+        {
+            bitword* row = SLABROW(red_mat, next_row[card]++, red_word_count);
+            int k = 0;
+            for (k = 0; k < red_rx_count; k++)
+            {
+                if (WORDTEST(initial_mat + mcs_ix * word_count, left_cols[k]))
+                {
+                    WORDSET(row, k);
+                }
+            }
+        }
+    }
+    free(next_row);
+    return MCS_OK;
+}		/* -----  end of function processMatrix  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  filterMcsRows
+ *  Description:  removes rows of the matrix mat of readMcsFile that are no
+ *                minimal cutsets, rows left keep their order
+ *                  - equal rows are found by a hash table of the rows, the
+ *                    first row is kept
+ *                  - supersets of other rows are found by a set trie of
+ *                    the rows kept, rows are checked with increasing
+ *                    cardinality
+ *                mcs_card, mcs_card_sum and mcs_count are updated and the
+ *                removed rows are counted in duplicate_count and
+ *                superset_count
+ *                returns MCS_OK or MCS_ERROR_RAM
+ * =====================================================================================
+ */
+    int
+filterMcsRows(bitword* mat, int* mcs_card, unsigned long* mcs_card_sum,
+        unsigned long* mcs_count, int rx_count, unsigned long*
+        duplicate_count, unsigned long* superset_count)
+{
+    int           word_count = getWordCount(rx_count);
+    unsigned long row_count  = *mcs_count;
+    unsigned long table_size = 1;
+    while (table_size < 2 * row_count)
+    {
+        table_size *= 2;
+    }
+    *duplicate_count = 0;
+    *superset_count  = 0;
+    unsigned char* keep  = malloc(row_count + 1);
+    unsigned long* table = calloc(table_size, sizeof(unsigned long));
+    if ( (NULL == keep) || (NULL == table) )
+    {
+        free(keep);
+        free(table);
+        return MCS_ERROR_RAM;
+    }
+
+    // the table holds row + 1 of the first row of each hash
+    unsigned long li;
+    int           w;
+    for (li = 0; li < row_count; li++)
+    {
+        bitword* row  = SLABROW(mat, li, word_count);
+        uint64_t hash = 0;
+        for (w = 0; w < word_count; w++)
+        {
+            hash = hashMcsRowKey(hash ^ row[w]);
+        }
+        unsigned long slot = hash & (table_size - 1);
+        keep[li] = 1;
+        while (table[slot])
+        {
+            if (!memcmp(SLABROW(mat, table[slot] - 1, word_count), row,
+                        word_count * sizeof(bitword)))
+            {
+                keep[li] = 0;
+                (*duplicate_count)++;
+                break;
+            }
+            slot = (slot + 1) & (table_size - 1);
+        }
+        if (keep[li])
+        {
+            table[slot] = li + 1;
+        }
+    }
+    free(table);
+
+    // order rows by cardinality
+    unsigned long* order = malloc((row_count + 1) * sizeof(unsigned long));
+    unsigned long* next  = malloc((rx_count + 1) * sizeof(unsigned long));
+    int*           set   = malloc((rx_count + 1) * sizeof(int));
+    struct set_trie trie;
+    if ( (NULL == order) || (NULL == next) || (NULL == set) ||
+            !initSetTrie(&trie, mat, 0, rx_count, word_count) )
+    {
+        free(keep);
+        free(order);
+        free(next);
+        free(set);
+        return MCS_ERROR_RAM;
+    }
+    int card;
+    next[0] = 0;
+    for (card = 1; card < rx_count; card++)
+    {
+        next[card] = next[card - 1] + mcs_card_sum[card - 1];
+    }
+    for (li = 0; li < row_count; li++)
+    {
+        order[next[mcs_card[li]]++] = li;
+    }
+    free(next);
+
+    // rows are supersets if a row of lower cardinality is their subset
+    int           status = MCS_OK;
+    unsigned long id     = 0;
+    unsigned long oi;
+    for (oi = 0; (oi < row_count) && (MCS_OK == status); oi++)
+    {
+        li = order[oi];
+        if (!keep[li])
+        {
+            continue;
+        }
+        bitword* row       = SLABROW(mat, li, word_count);
+        int      set_count = 0;
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                set[set_count++] = w * WORDBITS + __builtin_ctzll(bits);
+                bits &= bits - 1;
+            }
+        }
+        if (trieHasSubset(&trie, set, set_count, TRIE_NONE))
+        {
+            keep[li] = 0;
+            (*superset_count)++;
+        }
+        else if ( (id >= TRIE_NONE - 1) || !insertTrieSet(&trie, row,
+                    word_count, id++) )
+        {
+            status = MCS_ERROR_RAM;
+        }
+    }
+    freeSetTrie(&trie);
+    free(order);
+    free(set);
+
+    // move rows left together
+    unsigned long left = 0;
+    for (li = 0; (li < row_count) && (MCS_OK == status); li++)
+    {
+        if (!keep[li])
+        {
+            mcs_card_sum[mcs_card[li]]--;
+            continue;
+        }
+        if (left < li)
+        {
+            memcpy(SLABROW(mat, left, word_count), SLABROW(mat, li,
+                        word_count), word_count * sizeof(bitword));
+            mcs_card[left] = mcs_card[li];
+        }
+        left++;
+    }
+    if (MCS_OK == status)
+    {
+        *mcs_count = left;
+    }
+    free(keep);
+    return status;
+}		/* -----  end of function filterMcsRows  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  hashMcsRowKey
+ *  Description:  returns a well mixed 64 bit key of row li
+ * =====================================================================================
+ */
+    uint64_t
+hashMcsRowKey(uint64_t li)
+{
+    uint64_t key = li + 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}		/* -----  end of function hashMcsRowKey  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  compressMatrix
+ *  Description:  merges reactions with equal columns in all red_mcs_count
+ *                rows of the slab red_mat into one column of the new slab
+ *                comp_mat of comp_rx_count columns
+ *                  - a column of comp_mat stands for rx_weights[column]
+ *                    reactions, rx_weights needs red_rx_count entries
+ *                  - columns keep the order of their first reaction
+ *                  - columns are grouped by two sums of row keys and each
+ *                    group is checked on all rows, groups of different
+ *                    columns with equal sums are not merged
+ *                comp_mat is NULL if no reactions are merged
+ *                returns MCS_OK or MCS_ERROR_RAM
+ * =====================================================================================
+ */
+    int
+compressMatrix(bitword* red_mat, unsigned long red_mcs_count, int
+        red_rx_count, bitword** comp_mat, int* comp_rx_count, int*
+        rx_weights)
+{
+    int red_word_count = getWordCount(red_rx_count);
+    int table_size     = 1;
+    while (table_size < 2 * red_rx_count)
+    {
+        table_size *= 2;
+    }
+    uint64_t* sums  = calloc(2 * red_rx_count + 1, sizeof(uint64_t));
+    int*      rep   = malloc((red_rx_count + 1) * sizeof(int));
+    int*      size  = calloc(red_rx_count + 1, sizeof(int));
+    int*      seen  = calloc(red_rx_count + 1, sizeof(int));
+    int*      table = malloc(table_size * sizeof(int));
+    *comp_mat      = NULL;
+    *comp_rx_count = red_rx_count;
+    if ( (NULL == sums) || (NULL == rep) || (NULL == size) || (NULL == seen)
+            || (NULL == table) )
+    {
+        free(sums);
+        free(rep);
+        free(size);
+        free(seen);
+        free(table);
+        return MCS_ERROR_RAM;
+    }
+
+    // sum two keys of the rows of each column
+    unsigned long li;
+    int           w;
+    for (li = 0; li < red_mcs_count; li++)
+    {
+        bitword* row  = SLABROW(red_mat, li, red_word_count);
+        uint64_t key1 = hashMcsRowKey(2 * li);
+        uint64_t key2 = hashMcsRowKey(2 * li + 1);
+        for (w = 0; w < red_word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                int rx = w * WORDBITS + __builtin_ctzll(bits);
+                sums[2 * rx]     += key1;
+                sums[2 * rx + 1] += key2;
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // first reaction of equal sums represents its group
+    int rx;
+    for (rx = 0; rx < table_size; rx++)
+    {
+        table[rx] = -1;
+    }
+    for (rx = 0; rx < red_rx_count; rx++)
+    {
+        int slot = (int)(sums[2 * rx] & (table_size - 1));
+        while ( (table[slot] >= 0) && ( (sums[2 * table[slot]] != sums[2 *
+                            rx]) || (sums[2 * table[slot] + 1] != sums[2 *
+                                rx + 1]) ) )
+        {
+            slot = (slot + 1) & (table_size - 1);
+        }
+        if (table[slot] < 0)
+        {
+            table[slot] = rx;
+        }
+        rep[rx] = table[slot];
+        size[rep[rx]]++;
+    }
+    free(table);
+
+    // each row needs to contain all or none reactions of a group
+    // seen counts the reactions of each group in the row, a negative size
+    // marks groups of different columns
+    for (li = 0; li < red_mcs_count; li++)
+    {
+        bitword* row = SLABROW(red_mat, li, red_word_count);
+        int      pass;
+        for (pass = 0; pass < 3; pass++)
+        {
+            for (w = 0; w < red_word_count; w++)
+            {
+                bitword bits = row[w];
+                while (bits)
+                {
+                    int group = rep[w * WORDBITS + __builtin_ctzll(bits)];
+                    if (pass == 0)
+                    {
+                        seen[group]++;
+                    }
+                    else if (pass == 1)
+                    {
+                        if ( (size[group] > 0) && (seen[group] !=
+                                    size[group]) )
+                        {
+                            size[group] = -size[group];
+                        }
+                    }
+                    else
+                    {
+                        seen[group] = 0;
+                    }
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    // number the merged columns
+    int* column = seen;
+    *comp_rx_count = 0;
+    for (rx = 0; rx < red_rx_count; rx++)
+    {
+        if (size[rep[rx]] < 0)
+        {
+            rep[rx] = rx;
+        }
+        if (rep[rx] == rx)
+        {
+            column[rx]                 = *comp_rx_count;
+            rx_weights[*comp_rx_count] = 0;
+            (*comp_rx_count)++;
+        }
+        rx_weights[column[rep[rx]]]++;
+    }
+    free(sums);
+    free(size);
+    if (*comp_rx_count == red_rx_count)
+    {
+        free(rep);
+        free(seen);
+        return MCS_OK;
+    }
+
+    int comp_word_count = getWordCount(*comp_rx_count);
+    *comp_mat = newBitsetSlab(red_mcs_count, comp_word_count);
+    if (NULL == *comp_mat)
+    {
+        free(rep);
+        free(seen);
+        return MCS_ERROR_RAM;
+    }
+    for (li = 0; li < red_mcs_count; li++)
+    {
+        bitword* row      = SLABROW(red_mat, li, red_word_count);
+        bitword* comp_row = SLABROW(*comp_mat, li, comp_word_count);
+        for (w = 0; w < red_word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                WORDSET(comp_row, column[rep[w * WORDBITS +
+                        __builtin_ctzll(bits)]]);
+                bits &= bits - 1;
+            }
+        }
+    }
+    free(rep);
+    free(seen);
+    return MCS_OK;
+}		/* -----  end of function compressMatrix  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  compareMcsRows
+ *  Description:  compares the rows of compareMat with the indices a and b
+ *                lexicographically by their ascending reactions, rows
+ *                containing the lowest reaction in which they differ come
+ *                first
+ * =====================================================================================
+ */
+    int
+compareMcsRows(const void* a, const void* b)
+{
+    bitword* row_a = SLABROW(compareMat, *(const uint32_t*)a,
+            compareWordCount);
+    bitword* row_b = SLABROW(compareMat, *(const uint32_t*)b,
+            compareWordCount);
+    int w;
+    for (w = 0; w < compareWordCount; w++)
+    {
+        bitword diff = row_a[w] ^ row_b[w];
+        if (diff)
+        {
+            return (row_a[w] & diff & -diff) ? -1 : 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function compareMcsRows  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  compareReactionFreq
+ *  Description:  orders the reactions a and b by decreasing compareFreq,
+ *                reactions of equal frequency keep their order
+ * =====================================================================================
+ */
+    int
+compareReactionFreq(const void* a, const void* b)
+{
+    int rx_a = *(const int*)a;
+    int rx_b = *(const int*)b;
+    if (compareFreq[rx_a] != compareFreq[rx_b])
+    {
+        return compareFreq[rx_a] > compareFreq[rx_b] ? -1 : 1;
+    }
+    return rx_a < rx_b ? -1 : (rx_a > rx_b);
+}		/* -----  end of function compareReactionFreq  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  reorderMatrix
+ *  Description:  copies the red_mcs_count rows of the slab red_mat, which
+ *                are sorted by cardinality, into the new slab ord_mat
+ *                  - if order_columns, reactions are renumbered by
+ *                    decreasing number of mcs containing them, frequent
+ *                    reactions share the first words of each row
+ *                  - if order_rows, rows of equal cardinality are sorted
+ *                    by compareMcsRows, rows sharing their first reactions
+ *                    become neighbours
+ *                returns MCS_OK or MCS_ERROR_RAM
+ * =====================================================================================
+ */
+    int
+reorderMatrix(bitword* red_mat, unsigned long red_mcs_count, int
+        red_rx_count, int order_columns, int order_rows, bitword** ord_mat)
+{
+    int            word_count = getWordCount(red_rx_count);
+    unsigned long* freq       = calloc(red_rx_count + 1, sizeof(unsigned
+                long));
+    int*           column     = malloc((red_rx_count + 1) * sizeof(int));
+    int*           ranked     = malloc((red_rx_count + 1) * sizeof(int));
+    uint32_t*      order      = malloc((red_mcs_count + 1) *
+            sizeof(uint32_t));
+    bitword*       done       = calloc(WORDNSLOTS(red_mcs_count) + 1,
+            sizeof(bitword));
+    bitword*       spare      = malloc((word_count + 1) * sizeof(bitword));
+    *ord_mat = newBitsetSlab(red_mcs_count, word_count);
+    if ( (NULL == freq) || (NULL == column) || (NULL == ranked) || (NULL ==
+                order) || (NULL == done) || (NULL == spare) || (NULL ==
+                *ord_mat) )
+    {
+        free(freq);
+        free(column);
+        free(ranked);
+        free(order);
+        free(done);
+        free(spare);
+        free(*ord_mat);
+        *ord_mat = NULL;
+        return MCS_ERROR_RAM;
+    }
+
+    // new column of each reaction, equal frequencies keep their order
+    unsigned long li;
+    int           w;
+    int           rx;
+    for (li = 0; li < red_mcs_count; li++)
+    {
+        bitword* row = SLABROW(red_mat, li, word_count);
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                freq[w * WORDBITS + __builtin_ctzll(bits)]++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    for (rx = 0; rx < red_rx_count; rx++)
+    {
+        ranked[rx] = rx;
+    }
+    if (order_columns)
+    {
+        compareFreq = freq;
+        qsort(ranked, red_rx_count, sizeof(int), compareReactionFreq);
+        compareFreq = NULL;
+    }
+    for (rx = 0; rx < red_rx_count; rx++)
+    {
+        column[ranked[rx]] = rx;
+    }
+    free(freq);
+    free(ranked);
+
+    for (li = 0; li < red_mcs_count; li++)
+    {
+        bitword* row     = SLABROW(red_mat, li, word_count);
+        bitword* ord_row = SLABROW(*ord_mat, li, word_count);
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                WORDSET(ord_row, column[w * WORDBITS +
+                        __builtin_ctzll(bits)]);
+                bits &= bits - 1;
+            }
+        }
+    }
+    free(column);
+
+    // sort each block of rows with equal cardinality
+    if (order_rows)
+    {
+        compareMat       = *ord_mat;
+        compareWordCount = word_count;
+        unsigned long first = 0;
+        while (first < red_mcs_count)
+        {
+            int           card = bitsetCount(SLABROW(*ord_mat, first,
+                        word_count), word_count);
+            unsigned long last = first + 1;
+            while ( (last < red_mcs_count) && (bitsetCount(SLABROW(*ord_mat,
+                                last, word_count), word_count) == card) )
+            {
+                last++;
+            }
+            for (li = first; li < last; li++)
+            {
+                order[li - first] = li;
+            }
+            qsort(order, last - first, sizeof(uint32_t), compareMcsRows);
+
+            // row li takes row order[li - first], the permutation is
+            // applied cycle by cycle with one spare row
+            for (li = first; li < last; li++)
+            {
+                if (WORDTEST(done, li))
+                {
+                    continue;
+                }
+                unsigned long target = li;
+                bitsetCopy(spare, SLABROW(*ord_mat, li, word_count),
+                        word_count);
+                while (order[target - first] != li)
+                {
+                    unsigned long source = order[target - first];
+                    bitsetCopy(SLABROW(*ord_mat, target, word_count),
+                            SLABROW(*ord_mat, source, word_count),
+                            word_count);
+                    WORDSET(done, target);
+                    target = source;
+                }
+                bitsetCopy(SLABROW(*ord_mat, target, word_count), spare,
+                        word_count);
+                WORDSET(done, target);
+            }
+            first = last;
+        }
+        compareMat = NULL;
+    }
+    free(order);
+    free(done);
+    free(spare);
+    return MCS_OK;
+}		/* -----  end of function reorderMatrix  ----- */
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "generalFunctions.c"
+#include "combinatorics.c"
+#include "pfMethods.c"
+#include "shardMethods.c"
+
+#define MAX_ARGS       3
+#define ERROR_ARGS     1
+#define ERROR_FILE     4
+#define ERROR_RAM      5
+#define ERROR_INPUT    6
+
+void printHeader(FILE *file_out, int line_length, double lambda)
+{
+    // print output header to stdout
+    printLine('=', line_length);
+    printf("%4s     %3s    %20s     %10s     %25s     %25s\n", "n", "d",
+            "weighted P(f)", "P(f)", "total cutsets(d)", 
+            "possible cutsets(d)");
+    printf("%19slambda = %1.2e\n"," ", lambda);
+    printLine('-', line_length);
+
+    // print output header to output file
+    fprintLine(file_out, '=', line_length);
+    fprintf(file_out, "%4s     %3s    %20s     %10s     %25s     %25s\n", "n",
+            "d", "weighted P(f)", "P(f)", "total cutsets(d)", 
+            "possible cutsets(d)");
+    fprintf(file_out, "%19slambda = %1.2e\n"," ", lambda);
+    fprintLine(file_out, '-', line_length);
+}
+
+void printFooter(FILE *file_out, int line_length, double total_weight_pF, double left_weight)
+{
+    // print footer to stdout
+    printLine('-', line_length);
+    printf("total P(f)              %3.10lf\n", total_weight_pF);
+    printf("Error                   %3.10f\n", left_weight); 
+    printLine('=', line_length);
+
+    // print footer to output file
+    fprintLine(file_out, '-', line_length);
+    fprintf(file_out, "total P(f)              %3.10lf\n", total_weight_pF);
+    fprintf(file_out, "Error                   %3.10f\n", left_weight); 
+    fprintLine(file_out, '=', line_length);
+}
+
+/**
+ * read shard file and add its partial cutsets to total
+ *   - the first shard defines header and base cutsets, all further shards
+ *     have to match them
+ *   - seen marks the shards that were read
+ */
+void readShard(char* filename, struct shard_header* first, uint128** total,
+        char** seen)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+    {
+        quitError("Error in opening shard file\n", ERROR_FILE);
+    }
+    struct shard_header header;
+    if (SHARD_OK != readShardHeader(file, &header))
+    {
+        quitError("Shard file is not valid\n", ERROR_INPUT);
+    }
+    if (NULL == *total)
+    {
+        *first = header;
+        *total = calloc(2 * header.max_card, sizeof(uint128));
+        *seen  = calloc(header.shard_count, sizeof(char));
+        if ( (NULL == *total) || (NULL == *seen) )
+        {
+            quitError("Not enough free memory\n", ERROR_RAM);
+        }
+    }
+    else if ( (header.max_card != first->max_card) || (header.shard_count !=
+                first->shard_count) || (header.hash != first->hash) ||
+            (header.rx_count != first->rx_count) || (header.lambda !=
+                first->lambda) )
+    {
+        quitError("Shards belong to different runs\n", ERROR_INPUT);
+    }
+    if ((*seen)[header.shard])
+    {
+        quitError("Shard is given twice\n", ERROR_INPUT);
+    }
+    (*seen)[header.shard] = 1;
+
+    // base cutsets are stored in front of the summed partial cutsets
+    uint128* base    = malloc(2 * header.max_card * sizeof(uint128));
+    uint128* partial = base + header.max_card;
+    if (NULL == base)
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+    if (fread(base, sizeof(uint128), 2 * header.max_card, file) != 2 *
+            header.max_card)
+    {
+        quitError("Shard file is not valid\n", ERROR_INPUT);
+    }
+    fclose(file);
+    unsigned int card;
+    for (card = 0; card < header.max_card; card++)
+    {
+        if ( (header.shard != first->shard) && ((*total)[card] !=
+                    base[card]) )
+        {
+            quitError("Shards belong to different runs\n", ERROR_INPUT);
+        }
+        (*total)[card] = base[card];
+        (*total)[header.max_card + card] += partial[card];
+    }
+    free(base);
+}
+
+int main (int argc, char *argv[])
+{
+    // read arguments
+    char *optv[MAX_ARGS] = { "-i", "-o", "-l" };
+    char *optd[MAX_ARGS] = { 
+        "comma separated shard files of failureProbabilityByMcs --shard", 
+        "output file",
+        "lambda = weighting factor ( > 0 ) [default=lambda of shards]"
+    };
+    char *optr[MAX_ARGS];
+    char *description = "Merge shards of failureProbabilityByMcs into the \
+failure probability of the network";
+    char *usg = "mergeFailureShards -i shard1.bin,shard2.bin -o failure.out";
+
+    readArgs(argc, argv, MAX_ARGS, optv, optr);
+
+    // check if compulsory arguments are given
+    if ( (!optr[0]) || (!optr[1]) )
+    {
+        usage(description, usg, MAX_ARGS, optv, optd);
+        quitError("Missing argument\n", ERROR_ARGS);
+    }
+
+    // sum partial cutsets of all shards
+    struct shard_header header;
+    uint128* total = NULL;
+    char*    seen  = NULL;
+    char*    filename;
+    for (filename = strtok(optr[0], ","); filename; filename = strtok(NULL,
+                ","))
+    {
+        readShard(filename, &header, &total, &seen);
+    }
+    if (NULL == total)
+    {
+        quitError("Missing argument\n", ERROR_ARGS);
+    }
+    unsigned int i;
+    for (i = 0; i < header.shard_count; i++)
+    {
+        if (!seen[i])
+        {
+            fprintf(stderr, "Shard %u/%u is missing\n", i + 1,
+                    header.shard_count);
+            quitError("Not all shards are given\n", ERROR_INPUT);
+        }
+    }
+
+    // define lambda for weighting function
+    double lambda = header.lambda;
+    if (optr[2])
+    {
+        lambda = atof(optr[2]);
+    }
+    if (lambda <= 0)
+    {
+        quitError("lambda needs to be greater than zero\n\n", ERROR_ARGS);
+    }
+
+    // open output file
+    FILE *file_out = fopen(optr[1], "w");
+    if (!file_out)
+    {
+        quitError("Error in opening outputfile\n", ERROR_FILE);
+    }
+
+    // precompute binomials needed for the number of possible cutsets
+    int rx_count = header.rx_count;
+    int max_card = header.max_card;
+    if (!initBinomTable(rx_count, max_card))
+    {
+        quitError("Not enough free memory for binomial table\n", ERROR_RAM);
+    }
+
+    int line_length = 111;
+
+    printHeader(file_out, line_length, lambda);
+
+    // calculate failure probability
+    int    card;
+    double total_weight_pF = 0;
+    for (card = 0; card < max_card; card++)
+    {
+        uint128 card_cutsets = total[card] + total[max_card + card];
+        uint128 all_possible = chooseExact(rx_count, (card + 1));
+        char    card_cutsets_str[40];
+        char    all_possible_str[40];
+        sprintUint128(card_cutsets_str, card_cutsets);
+        sprintUint128(all_possible_str, all_possible);
+        double failure = (double)card_cutsets/(double)all_possible;
+        double weight = getWeight(lambda, card+1);
+        double weight_pF = weight * failure;
+
+        total_weight_pF += weight_pF;
+
+        printf("%4d     %3d            %.10lf     %.8f     %25s     %25s\n",
+                rx_count, card + 1, weight_pF, failure, card_cutsets_str,
+                all_possible_str);
+        fprintf(file_out, 
+                "%4d     %3d            %.10lf     %.8f     %25s     %25s\n",
+                rx_count, card + 1, weight_pF, failure, card_cutsets_str,
+                all_possible_str);
+    }
+
+    // weight of deletions that were not analysed
+    double left_weight = getTailWeight(lambda, max_card);
+
+    printFooter(file_out, line_length, total_weight_pF, left_weight);
+
+    fclose(file_out);
+    free(total);
+    free(seen);
+    freeBinomTable();
+
+    return EXIT_SUCCESS;
+}
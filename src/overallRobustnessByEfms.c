@@ -135,6 +135,13 @@ int main (int argc, char *argv[])
                 ERROR_FILE);
     }
 
+    // precompute log factorials, binomials of all numbers of knockouts are
+    // taken from them, an exact table would need (rx_count + 1)^2 entries
+    if (!initBinomTable(rx_count, 0))
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+
     // allocate memory for EFM cardinalities
     int* efm_card = calloc(rx_count, sizeof(int));
     if (NULL == efm_card) 
@@ -172,6 +179,7 @@ int main (int argc, char *argv[])
 
     // free memory
     free(efm_card);
+    freeBinomTable();
 
     return EXIT_SUCCESS;
 }
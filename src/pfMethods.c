@@ -54,6 +54,7 @@
 #include <math.h>
 
 double getWeight(double lambda, int deletions);
+double getTailWeight(double lambda, int deletions);
 
 /* 
  * ===  FUNCTION  ======================================================================
@@ -64,15 +65,53 @@ double getWeight(double lambda, int deletions);
     double 
 getWeight(double lambda, int deletions)
 {
-    double logw = deletions * log(lambda) - lambda;
-    if (deletions > 1)
+    double logw = deletions * log(lambda) - lambda - logFactorial(deletions);
+    double w = exp(logw);
+    return w;
+}
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getTailWeight
+ *  Description:  calculates the sum of weighting factors of all numbers of
+ *                deletions larger than deletions
+ *                if the mode floor(lambda) lies beyond deletions the tail
+ *                holds most of the weight and is calculated as 1 - CDF, the
+ *                first tail terms may underflow to 0 there
+ *                otherwise the terms decrease, they are summed directly
+ *                instead of subtracting from 1 - exp(-lambda) and the
+ *                truncated rest is bounded by a geometric series, so the
+ *                result is an upper bound
+ * =====================================================================================
+ */
+    double 
+getTailWeight(double lambda, int deletions)
+{
+    if (floor(lambda) > deletions)
     {
-        int i;
-        for (i = 2; i <= deletions; i++)
+        double cdf = 0;
+        int    d;
+        for (d = 0; d <= deletions; d++)
         {
-            logw -= log(i);
+            cdf += getWeight(lambda, d);
         }
+        return cdf < 1 ? 1 - cdf : 0;
     }
-    double w = exp(logw);
-    return w;
-}
+    double tail = 0;
+    int    k    = deletions + 1;
+    double w    = getWeight(lambda, k);
+    while (w > 0)
+    {
+        tail += w;
+        // ratio of consecutive weights is lambda / (k + 1)
+        double ratio = lambda / (k + 1);
+        if ( (ratio < 0.5) && (w * ratio / (1 - ratio) <= tail * 1e-17) )
+        {
+            tail += w * ratio / (1 - ratio);
+            break;
+        }
+        k++;
+        w *= ratio;
+    }
+    return tail;
+}		/* -----  end of function getTailWeight  ----- */
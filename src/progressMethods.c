@@ -0,0 +1,444 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define PROGRESS_STEPS       80
+#define PROGRESS_LINE        64
+#define PROGRESS_INTERVAL_MS 250
+#define PROGRESS_STREAM_RATE 4
+
+// counter of one thread, each counter fills a cache line so threads do not
+// share lines when counting
+struct progress_counter
+{
+    unsigned long done;
+    char          pad[PROGRESS_LINE - sizeof(unsigned long)];
+} __attribute__((aligned(PROGRESS_LINE)));
+
+// progress of a calculation of total steps
+// threads only add to their counter, the reporter samples the sum of the
+// counters, draws the progress bar to stdout and writes one json line per
+// second to stream
+// output of other threads to stdout has to be enclosed by pauseProgress and
+// resumeProgress
+struct progress
+{
+    struct progress_counter* counters;
+    int                      counter_count;
+    unsigned long            total;
+    FILE*                    stream;
+    int                      bar_chars;
+    int                      running;
+    struct timespec          start;
+    pthread_t                reporter;
+    pthread_mutex_t          lock;
+    pthread_cond_t           stop;
+};
+
+int initProgress(struct progress* progress, int counter_count, FILE* stream);
+void freeProgress(struct progress* progress);
+void addProgress(struct progress* progress, int counter_id);
+unsigned long getProgressDone(struct progress* progress);
+void clearProgressBar();
+void startProgressReporter(struct progress* progress, unsigned long total);
+void stopProgressReporter(struct progress* progress);
+void pauseProgress(struct progress* progress);
+void resumeProgress(struct progress* progress);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initProgress
+ *  Description:  prepares counter_count counters, stream may be NULL
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+initProgress(struct progress* progress, int counter_count, FILE* stream)
+{
+    progress->counters      = NULL;
+    progress->counter_count = counter_count;
+    progress->total         = 0;
+    progress->stream        = stream;
+    progress->bar_chars     = 0;
+    progress->running       = 0;
+    if (posix_memalign((void**)&progress->counters, PROGRESS_LINE,
+                counter_count * sizeof(struct progress_counter)))
+    {
+        progress->counters = NULL;
+        return 0;
+    }
+    int i;
+    for (i = 0; i < counter_count; i++)
+    {
+        progress->counters[i].done = 0;
+    }
+    pthread_mutex_init(&progress->lock, NULL);
+    pthread_cond_init(&progress->stop, NULL);
+    return 1;
+}		/* -----  end of function initProgress  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeProgress
+ *  Description:  frees counters of progress
+ * =====================================================================================
+ */
+    void
+freeProgress(struct progress* progress)
+{
+    free(progress->counters);
+    progress->counters = NULL;
+    pthread_mutex_destroy(&progress->lock);
+    pthread_cond_destroy(&progress->stop);
+}		/* -----  end of function freeProgress  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  addProgress
+ *  Description:  counts one step of thread counter_id
+ *                only the owner writes its counter, so the step is a plain
+ *                atomic store that never waits for other threads
+ * =====================================================================================
+ */
+    void
+addProgress(struct progress* progress, int counter_id)
+{
+    unsigned long* done = &progress->counters[counter_id].done;
+    __atomic_store_n(done, __atomic_load_n(done, __ATOMIC_RELAXED) + 1,
+            __ATOMIC_RELAXED);
+}		/* -----  end of function addProgress  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getProgressDone
+ *  Description:  returns sum of all counters
+ * =====================================================================================
+ */
+    unsigned long
+getProgressDone(struct progress* progress)
+{
+    unsigned long done = 0;
+    int i;
+    for (i = 0; i < progress->counter_count; i++)
+    {
+        done += __atomic_load_n(&progress->counters[i].done,
+                __ATOMIC_RELAXED);
+    }
+    return done;
+}		/* -----  end of function getProgressDone  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  clearProgressBar
+ *  Description:  deletes progress bar from stdout
+ * =====================================================================================
+ */
+    void
+clearProgressBar()
+{
+    int ri;
+    int add = 40;
+    for (ri = 0; ri < add; ri++)
+    {
+        printf(" ");
+    }
+    int all = PROGRESS_STEPS + 2*add;
+    for (ri = 0; ri < all; ri++)
+    {
+        printf("\b");
+    }
+    fflush(stdout);
+}		/* -----  end of function clearProgressBar  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getProgressSeconds
+ *  Description:  returns seconds since start of reporter
+ * =====================================================================================
+ */
+    double
+getProgressSeconds(struct progress* progress)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - progress->start.tv_sec) + (now.tv_nsec -
+            progress->start.tv_nsec) / 1e9;
+}		/* -----  end of function getProgressSeconds  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeProgressSample
+ *  Description:  writes a json line of done steps to stream, expected left
+ *                seconds are -1 if they are not known yet
+ * =====================================================================================
+ */
+    void
+writeProgressSample(struct progress* progress, unsigned long done, double
+        elapsed, double prg, double expected)
+{
+    fprintf(progress->stream, "{\"elapsed\": %.1f, \"done\": %lu, "
+            "\"total\": %lu, \"percent\": %.2f, \"eta\": %.0f}\n",
+            elapsed, done, progress->total, prg, expected);
+    fflush(progress->stream);
+}		/* -----  end of function writeProgressSample  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  reportProgress
+ *  Description:  prints progress bar and expected left seconds of done
+ *                steps, writes a json line to stream if is_stream_sample
+ *                has to be called with the lock of progress
+ * =====================================================================================
+ */
+    void
+reportProgress(struct progress* progress, unsigned long done, int
+        is_stream_sample)
+{
+    double elapsed  = getProgressSeconds(progress);
+    double prg      = progress->total ? 100 * (double)done /
+        (double)progress->total : 100;
+    double expected = -1;
+    if ( (done > 0) && (elapsed >= 1) )
+    {
+        expected = elapsed * (100 - prg) / prg;
+    }
+
+    // define progress bar length
+    int i;
+    for (i = progress->bar_chars; i < PROGRESS_STEPS; i++)
+    {
+        if (done >= i * (progress->total / PROGRESS_STEPS))
+        {
+            progress->bar_chars = i;
+        }
+        else
+        {
+            i = PROGRESS_STEPS;
+        }
+    }
+
+    // clear progress bar and print new one
+    clearProgressBar();
+    printf("[");
+    for (i = 0; i < progress->bar_chars; i++)
+    {
+        printf("=");
+    }
+    printf(">");
+    for (i = progress->bar_chars; i < PROGRESS_STEPS; i++)
+    {
+        printf(" ");
+    }
+    printf("] ");
+    if (prg < 10)
+    {
+        printf(" ");
+    }
+    printf("%.2f%%", prg);
+    if (expected >= 0)
+    {
+        printf(" (%d sec) ", (int)expected);
+    }
+    else 
+    {
+        printf(" (??? sec) ");
+    }
+    fflush(stdout);
+
+    if (progress->stream && is_stream_sample)
+    {
+        writeProgressSample(progress, done, elapsed, prg, expected);
+    }
+}		/* -----  end of function reportProgress  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  runProgressReporter
+ *  Description:  samples the counters every PROGRESS_INTERVAL_MS until the
+ *                reporter is stopped
+ * =====================================================================================
+ */
+    void*
+runProgressReporter(void* pointer_progress)
+{
+    struct progress* progress = (struct progress*) pointer_progress;
+    unsigned long    sample   = 0;
+    unsigned long    last     = progress->total + 1;
+    pthread_mutex_lock(&progress->lock);
+    while (progress->running)
+    {
+        unsigned long done = getProgressDone(progress);
+        int is_stream_sample = (sample % PROGRESS_STREAM_RATE) == 0;
+        if ( (done != last) || is_stream_sample )
+        {
+            reportProgress(progress, done, is_stream_sample);
+            last = done;
+        }
+        sample++;
+
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_nsec += PROGRESS_INTERVAL_MS * 1000000L;
+        if (until.tv_nsec >= 1000000000L)
+        {
+            until.tv_sec++;
+            until.tv_nsec -= 1000000000L;
+        }
+        while (progress->running && (pthread_cond_timedwait(&progress->stop,
+                        &progress->lock, &until) == 0))
+        {
+        }
+    }
+    pthread_mutex_unlock(&progress->lock);
+    return((void *)NULL);
+}		/* -----  end of function runProgressReporter  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  startProgressReporter
+ *  Description:  resets the counters and starts the reporter thread for a
+ *                calculation of total steps
+ *                a running reporter keeps its counters and total, so
+ *                calculations in several parts can share one reporter
+ * =====================================================================================
+ */
+    void
+startProgressReporter(struct progress* progress, unsigned long total)
+{
+    if (progress->running)
+    {
+        return;
+    }
+    int i;
+    for (i = 0; i < progress->counter_count; i++)
+    {
+        progress->counters[i].done = 0;
+    }
+    progress->total     = total;
+    progress->bar_chars = 0;
+    progress->running   = 1;
+    clock_gettime(CLOCK_MONOTONIC, &progress->start);
+    pthread_create(&progress->reporter, NULL, runProgressReporter,
+            (void *)progress);
+}		/* -----  end of function startProgressReporter  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  stopProgressReporter
+ *  Description:  stops the reporter thread, writes the last sample to
+ *                stream and deletes the progress bar with its left overs
+ * =====================================================================================
+ */
+    void
+stopProgressReporter(struct progress* progress)
+{
+    pthread_mutex_lock(&progress->lock);
+    if (!progress->running)
+    {
+        pthread_mutex_unlock(&progress->lock);
+        return;
+    }
+    progress->running = 0;
+    pthread_cond_signal(&progress->stop);
+    pthread_mutex_unlock(&progress->lock);
+    pthread_join(progress->reporter, NULL);
+    if (progress->stream)
+    {
+        unsigned long done = getProgressDone(progress);
+        writeProgressSample(progress, done, getProgressSeconds(progress),
+                progress->total ? 100 * (double)done /
+                (double)progress->total : 100, 0);
+    }
+    clearProgressBar();
+    int ri;
+    int all = PROGRESS_STEPS + 40;
+    for (ri = 0; ri < all; ri++)
+    {
+        printf(" ");
+    }
+    for (ri = 0; ri < all; ri++)
+    {
+        printf("\b");
+    }
+    fflush(stdout);
+}		/* -----  end of function stopProgressReporter  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  pauseProgress
+ *  Description:  deletes the progress bar and keeps the reporter from
+ *                drawing until resumeProgress
+ * =====================================================================================
+ */
+    void
+pauseProgress(struct progress* progress)
+{
+    pthread_mutex_lock(&progress->lock);
+    clearProgressBar();
+}		/* -----  end of function pauseProgress  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  resumeProgress
+ *  Description:  lets the reporter draw the progress bar again
+ * =====================================================================================
+ */
+    void
+resumeProgress(struct progress* progress)
+{
+    pthread_mutex_unlock(&progress->lock);
+}		/* -----  end of function resumeProgress  ----- */
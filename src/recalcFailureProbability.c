@@ -67,10 +67,15 @@
 
 struct dataset
 {
-    int rx_number;
-    int deletions;
-    long long total_cs;
-    long long possible_cutsets;
+    int     rx_number;
+    int     deletions;
+    uint128 total_cs;
+    uint128 possible_cutsets;
+    int     is_estimate;
+    double  failure;
+    int     has_bounds;
+    double  failure_low;
+    double  failure_high;
 };
 
 /**
@@ -125,17 +130,34 @@ int readCutsets(FILE *file, struct dataset** ds)
                     {
                         m_ds[ix].deletions = atoi(str);
                     }
+                    else if (i == 4)
+                    {
+                        m_ds[ix].failure = atof(str);
+                    }
                     else if (i == 5)
                     {
-                        m_ds[ix].total_cs = atoll(str);
+                        // sampled cutsets are estimated, marked by ~
+                        m_ds[ix].is_estimate = (str[0] == '~');
+                        m_ds[ix].total_cs    = parseUint128(str +
+                                m_ds[ix].is_estimate);
                     }
                     else if (i == 6)
                     {
-                        m_ds[ix].possible_cutsets = atoll(str);
+                        m_ds[ix].possible_cutsets = parseUint128(str);
+                    }
+                    else if (i == 7)
+                    {
+                        m_ds[ix].failure_low = atof(str);
+                    }
+                    else if (i == 8)
+                    {
+                        m_ds[ix].failure_high = atof(str);
                     }
                     str = strtok(NULL, "\n ");
                 }
-                if (i != 6)
+                // sampled outputs bound P(f) by two more columns
+                m_ds[ix].has_bounds = (i == 8);
+                if ( (i != 6) && (i != 8) )
                 {
                     quitError("Not a valid input file\n", ERROR_FILE);
                 }
@@ -198,42 +220,64 @@ int main (int argc, char *argv[])
     int max_card = readCutsets(file, &dataset);
     fclose(file);
 
-    int line_length = 111;
+    // precompute factorials needed by the weighting function
+    if (!initBinomTable(max_card, 0))
+    {
+        quitError("Not enough free memory\n", ERROR_RAM);
+    }
+
+    int  line_length = dataset[0].has_bounds ? 141 : 111;
+    char bounds[32]  = "";
+    if (dataset[0].has_bounds)
+    {
+        sprintf(bounds, "     %10s     %10s", "P(f) low", "P(f) high");
+    }
 
     // print output header to stdout
     printLine('=', line_length);
-    printf("%4s     %3s    %20s     %10s     %25s     %25s\n", "n", "d",
+    printf("%4s     %3s    %20s     %10s     %25s     %25s%s\n", "n", "d",
             "weighted P(f)", "P(f)", "total cutsets(d)", 
-            "possible cutsets(d)");
+            "possible cutsets(d)", bounds);
     printf("%19slambda = %1.2e\n"," ", lambda);
     printLine('-', line_length);
 
     // calculate failure probability
     int    card;
     double total_weight_pF = 0;
-    double left_weight = 1 - exp(-lambda);
     for (card = 0; card < max_card; card++)
     {
-        double failure = (double)dataset[card].total_cs/(double)dataset[card].possible_cutsets;
+        // the estimated number of cutsets is rounded, its P(f) is the
+        // sampled fraction
+        double failure = dataset[card].failure;
+        if (!dataset[card].is_estimate)
+        {
+            failure = (double)dataset[card].total_cs/(double)dataset[card].possible_cutsets;
+        }
         double weight = getWeight(lambda, card+1);
         double weight_pF = weight * failure;
 
         total_weight_pF += weight_pF;
-        left_weight -= weight;
 
-        printf("%4d     %3d            %.10lf     %.8f     %25.0lld     %25.0lld", 
+        char total_cs_str[41] = "~";
+        char possible_cutsets_str[40];
+        sprintUint128(total_cs_str + dataset[card].is_estimate,
+                dataset[card].total_cs);
+        sprintUint128(possible_cutsets_str, dataset[card].possible_cutsets);
+        printf("%4d     %3d            %.10lf     %.8f     %25s     %25s", 
                 dataset[card].rx_number, card + 1, weight_pF, failure,
-                dataset[card].total_cs, dataset[card].possible_cutsets);
+                total_cs_str, possible_cutsets_str);
+        if (dataset[card].has_bounds)
+        {
+            printf("     %.8f     %.8f", dataset[card].failure_low,
+                    dataset[card].failure_high);
+        }
 
         printf("\n");
     }
 
-    // weight cannot be less than 0; values < 0 are results of numerical
-    // instability of double values
-    if (left_weight < 0)
-    {
-        left_weight = 0;
-    }
+    // weight of deletions that were not analysed, summed directly as in
+    // failureProbabilityByMcs
+    double left_weight = getTailWeight(lambda, max_card);
 
     // print footer to stdout
     printLine('-', line_length);
@@ -242,6 +286,7 @@ int main (int argc, char *argv[])
     printLine('=', line_length);
 
     free(dataset);
+    freeBinomTable();
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_OK        0
+#define SAMPLE_ERROR_RAM 1
+#define SAMPLE_BATCH     1024
+#define SAMPLE_MAX_BATCH 1048576
+#define SAMPLE_Z         1.959963984540054
+#define SAMPLE_SEED      0x853c49e6748fea9bULL
+
+// estimate of the fraction of knockout sets of one cardinality that are
+// cutsets, low and high bound the 95% wilson score interval
+struct sample_result
+{
+    unsigned long samples;
+    unsigned long hits;
+    double        fraction;
+    double        low;
+    double        high;
+};
+
+// knockout sets drawn by one thread
+//   - reactions red_rx_count ... rx_count - 1 are single knockouts
+//   - mcs are found in trie or by checking the rows of mat if trie is NULL
+//   - perm is a permutation of all reactions, its first card entries are
+//     the knockout set
+struct sample_worker
+{
+    struct set_trie* trie;
+    bitword*         mat;
+    unsigned long    row_count;
+    int              red_rx_count;
+    int              rx_count;
+    int              card;
+    unsigned long    quota;
+    unsigned long    hits;
+    uint64_t         rng;
+    int*             perm;
+    int*             set;
+    bitword*         knockouts;
+};
+
+uint64_t nextSampleRandom(uint64_t* state);
+int isSampleCutset(struct sample_worker* worker);
+void *drawSamples(void *pointer_worker);
+void setSampleInterval(struct sample_result* result);
+int sampleCutsets(struct set_trie* trie, bitword* mat, unsigned long
+        row_count, int red_rx_count, int rx_count, int card, unsigned long
+        max_samples, double rel_error, int thread_count, uint64_t seed,
+        struct sample_result* result);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  nextSampleRandom
+ *  Description:  returns the next number of the xorshift64* generator state
+ * =====================================================================================
+ */
+    uint64_t
+nextSampleRandom(uint64_t* state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545f4914f6cdd1dULL;
+}		/* -----  end of function nextSampleRandom  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  isSampleCutset
+ *  Description:  returns 1 if the knockout set of worker contains a single
+ *                knockout or a mcs
+ * =====================================================================================
+ */
+    int
+isSampleCutset(struct sample_worker* worker)
+{
+    int word_count = getWordCount(worker->red_rx_count);
+    int set_count  = 0;
+    int i;
+    for (i = 0; i < worker->card; i++)
+    {
+        int rx = worker->perm[i];
+        if (rx >= worker->red_rx_count)
+        {
+            return 1;
+        }
+        // insertion sort, the trie needs ascending reactions
+        int j = set_count++;
+        while ( (j > 0) && (worker->set[j - 1] > rx) )
+        {
+            worker->set[j] = worker->set[j - 1];
+            j--;
+        }
+        worker->set[j] = rx;
+    }
+    if (worker->trie)
+    {
+        return trieHasSubset(worker->trie, worker->set, set_count,
+                TRIE_NONE);
+    }
+
+    // a mcs is part of the knockouts if none of its reactions is left
+    memset(worker->knockouts, 0, word_count * sizeof(bitword));
+    for (i = 0; i < set_count; i++)
+    {
+        WORDSET(worker->knockouts, worker->set[i]);
+    }
+    unsigned long li;
+    for (li = 0; li < worker->row_count; li++)
+    {
+        if (!bitsetCountAndNotKernel(SLABROW(worker->mat, li, word_count),
+                    worker->knockouts, word_count))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function isSampleCutset  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  drawSamples
+ *  Description:  thread function drawing quota uniform knockout sets of
+ *                card reactions by a partial fisher-yates shuffle and
+ *                counting the cutsets among them in hits
+ * =====================================================================================
+ */
+    void*
+drawSamples(void *pointer_worker)
+{
+    struct sample_worker* worker = (struct sample_worker*) pointer_worker;
+    unsigned long         si;
+    worker->hits = 0;
+    for (si = 0; si < worker->quota; si++)
+    {
+        int i;
+        for (i = 0; i < worker->card; i++)
+        {
+            uint64_t range = worker->rx_count - i;
+            int      j     = i + (int)(((unsigned __int128)nextSampleRandom(
+                            &worker->rng) * range) >> 64);
+            int      rx    = worker->perm[i];
+            worker->perm[i] = worker->perm[j];
+            worker->perm[j] = rx;
+        }
+        worker->hits += isSampleCutset(worker);
+    }
+    return((void *)NULL);
+}		/* -----  end of function drawSamples  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  setSampleInterval
+ *  Description:  defines fraction and the 95% wilson score interval of the
+ *                samples and hits of result
+ * =====================================================================================
+ */
+    void
+setSampleInterval(struct sample_result* result)
+{
+    double n      = result->samples;
+    double p      = n > 0 ? result->hits / n : 0;
+    double z2     = SAMPLE_Z * SAMPLE_Z;
+    double denom  = 1 + z2 / n;
+    double center = (p + z2 / (2 * n)) / denom;
+    double half   = SAMPLE_Z * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) /
+        denom;
+    result->fraction = p;
+    result->low      = center - half > 0 ? center - half : 0;
+    result->high     = center + half < 1 ? center + half : 1;
+}		/* -----  end of function setSampleInterval  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  sampleCutsets
+ *  Description:  estimates the fraction of knockout sets of card of the
+ *                rx_count reactions that are cutsets
+ *                  - the first red_rx_count reactions are the columns of
+ *                    the row_count rows of the reduced matrix mat, all
+ *                    other reactions are single knockouts
+ *                  - mcs are found in trie or by checking all rows if
+ *                    trie is NULL
+ *                  - thread_count threads draw batches of growing size,
+ *                    each thread has its own generator derived from seed
+ *                  - sampling stops after max_samples or if the half width
+ *                    of the interval is below rel_error of the fraction
+ *                returns SAMPLE_OK or SAMPLE_ERROR_RAM
+ * =====================================================================================
+ */
+    int
+sampleCutsets(struct set_trie* trie, bitword* mat, unsigned long row_count,
+        int red_rx_count, int rx_count, int card, unsigned long max_samples,
+        double rel_error, int thread_count, uint64_t seed, struct
+        sample_result* result)
+{
+    int                   word_count = getWordCount(red_rx_count);
+    struct sample_worker* worker     = calloc(thread_count, sizeof(struct
+                sample_worker));
+    pthread_t*            thread     = malloc(thread_count *
+            sizeof(pthread_t));
+    int                   status     = SAMPLE_OK;
+    int                   t;
+    if ( (NULL == worker) || (NULL == thread) )
+    {
+        status = SAMPLE_ERROR_RAM;
+    }
+    for (t = 0; (t < thread_count) && (SAMPLE_OK == status); t++)
+    {
+        worker[t].trie         = trie;
+        worker[t].mat          = mat;
+        worker[t].row_count    = row_count;
+        worker[t].red_rx_count = red_rx_count;
+        worker[t].rx_count     = rx_count;
+        worker[t].card         = card;
+        worker[t].rng          = seed + 0x9e3779b97f4a7c15ULL * (t + 1);
+        worker[t].perm         = malloc((rx_count + 1) * sizeof(int));
+        worker[t].set          = malloc((card + 1) * sizeof(int));
+        worker[t].knockouts    = malloc((word_count + 1) * sizeof(bitword));
+        if ( (NULL == worker[t].perm) || (NULL == worker[t].set) || (NULL ==
+                    worker[t].knockouts) )
+        {
+            status = SAMPLE_ERROR_RAM;
+            break;
+        }
+        int rx;
+        for (rx = 0; rx < rx_count; rx++)
+        {
+            worker[t].perm[rx] = rx;
+        }
+        // xorshift needs a state different from zero
+        if (0 == worker[t].rng)
+        {
+            worker[t].rng = 1;
+        }
+    }
+
+    result->samples = 0;
+    result->hits    = 0;
+    unsigned long batch = SAMPLE_BATCH;
+    while ( (SAMPLE_OK == status) && (result->samples < max_samples) )
+    {
+        unsigned long left = max_samples - result->samples;
+        for (t = 0; t < thread_count; t++)
+        {
+            worker[t].quota = left / thread_count + ((unsigned long)t < left
+                    % thread_count);
+            if (worker[t].quota > batch)
+            {
+                worker[t].quota = batch;
+            }
+            pthread_create(&thread[t], NULL, drawSamples,
+                    (void *)&worker[t]);
+        }
+        for (t = 0; t < thread_count; t++)
+        {
+            pthread_join(thread[t], NULL);
+            result->samples += worker[t].quota;
+            result->hits    += worker[t].hits;
+        }
+        setSampleInterval(result);
+        if ( (result->hits > 0) && ((result->high - result->low) / 2 <=
+                    rel_error * result->fraction) )
+        {
+            break;
+        }
+        if (batch < SAMPLE_MAX_BATCH)
+        {
+            batch *= 2;
+        }
+    }
+
+    for (t = 0; worker && (t < thread_count); t++)
+    {
+        free(worker[t].perm);
+        free(worker[t].set);
+        free(worker[t].knockouts);
+    }
+    free(worker);
+    free(thread);
+    return status;
+}		/* -----  end of function sampleCutsets  ----- */
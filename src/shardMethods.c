@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SHARD_OK           0
+#define SHARD_ERROR_FILE   1
+#define SHARD_ERROR_FORMAT 3
+
+#define SHARD_MAGIC        "NRTSHRD"
+#define SHARD_VERSION      1
+
+// header of shard files written by failureProbabilityByMcs --shard
+// the header is followed by
+//   - uint128 base[max_card]: cutsets of d = card + 1 deletions given by
+//     mcs and single knockouts, equal in all shards
+//   - uint128 partial[max_card]: cutsets of d = card + 1 deletions found
+//     by the search of the mcs of the shard
+// hash identifies the reduced mcs
+struct shard_header
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t max_card;
+    uint32_t shard;
+    uint32_t shard_count;
+    uint64_t hash;
+    uint64_t rx_count;
+    double   lambda;
+};
+
+int getShardOfMcs(unsigned long position, int shard_count);
+int writeShard(FILE* out, struct shard_header* header, uint128* base,
+        uint128* partial);
+int readShardHeader(FILE* in, struct shard_header* header);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getShardOfMcs
+ *  Description:  returns shard 0 to shard_count - 1 of the mcs at position
+ *                in the order of decreasing search costs
+ *                shards take mcs in a snake order 0 .. n-1, n-1 .. 0, so all
+ *                shards get mcs of similar costs
+ * =====================================================================================
+ */
+    int
+getShardOfMcs(unsigned long position, int shard_count)
+{
+    unsigned long round = position % (2 * (unsigned long)shard_count);
+    if (round < (unsigned long)shard_count)
+    {
+        return round;
+    }
+    return 2 * shard_count - 1 - round;
+}		/* -----  end of function getShardOfMcs  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeShard
+ *  Description:  writes header, base and partial cutsets of a shard
+ *                returns SHARD_OK or SHARD_ERROR_FILE
+ * =====================================================================================
+ */
+    int
+writeShard(FILE* out, struct shard_header* header, uint128* base, uint128*
+        partial)
+{
+    memcpy(header->magic, SHARD_MAGIC, sizeof(SHARD_MAGIC));
+    header->version = SHARD_VERSION;
+    int ok = fwrite(header, sizeof(struct shard_header), 1, out) == 1;
+    ok = ok && fwrite(base, sizeof(uint128), header->max_card, out) ==
+        header->max_card;
+    ok = ok && fwrite(partial, sizeof(uint128), header->max_card, out) ==
+        header->max_card;
+    return ok ? SHARD_OK : SHARD_ERROR_FILE;
+}		/* -----  end of function writeShard  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  readShardHeader
+ *  Description:  reads and checks the header of a shard file, base and
+ *                partial cutsets follow with header.max_card values each
+ *                returns SHARD_OK or SHARD_ERROR_FORMAT
+ * =====================================================================================
+ */
+    int
+readShardHeader(FILE* in, struct shard_header* header)
+{
+    if ( (fread(header, sizeof(struct shard_header), 1, in) != 1) ||
+         memcmp(header->magic, SHARD_MAGIC, sizeof(SHARD_MAGIC)) ||
+         (header->version != SHARD_VERSION) || (header->max_card < 1) ||
+         (header->max_card > header->rx_count) ||
+         (header->shard >= header->shard_count) || (header->lambda <= 0) )
+    {
+        return SHARD_ERROR_FORMAT;
+    }
+    return SHARD_OK;
+}		/* -----  end of function readShardHeader  ----- */
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// counters of the cutset search of one thread for the mcs of one
+// cardinality
+// the counters are only updated if the program is compiled with
+// SEARCH_STATS, otherwise the macros below only mark stats as used
+struct search_stats
+{
+    unsigned long tasks;
+    unsigned long spawned;
+    unsigned long nodes;
+    unsigned long max_depth;
+    unsigned long rejected_card;
+    unsigned long subsets;
+    unsigned long contradicting;
+    unsigned long stored;
+    unsigned long candidates;
+    unsigned long chooses;
+    double        cpu_seconds;
+};
+
+#ifdef SEARCH_STATS
+#define STAT_ADD(stats, field, value) ((stats)->field += (value))
+#define STAT_MAX(stats, field, value) \
+    do \
+    { \
+        if ((stats)->field < (unsigned long)(value)) \
+        { \
+            (stats)->field = (value); \
+        } \
+    } while (0)
+#else
+#define STAT_ADD(stats, field, value) ((void)(stats))
+#define STAT_MAX(stats, field, value) ((void)(stats))
+#endif
+
+double getThreadCpuSeconds();
+void addSearchStats(struct search_stats* sum, struct search_stats* stats);
+void writeSearchStats(FILE* out, struct search_stats* stats);
+void writeStatsReport(FILE* out, struct search_stats* stats, int
+        thread_count, int card_count, unsigned long* mcs_counts, double*
+        wall_seconds, char* kernel_name, size_t* arena_peaks);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getThreadCpuSeconds
+ *  Description:  returns cpu seconds used by the calling thread
+ * =====================================================================================
+ */
+    double
+getThreadCpuSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}		/* -----  end of function getThreadCpuSeconds  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  addSearchStats
+ *  Description:  adds counters of stats to sum, the maximum depth is the
+ *                maximum of both
+ * =====================================================================================
+ */
+    void
+addSearchStats(struct search_stats* sum, struct search_stats* stats)
+{
+    sum->tasks         += stats->tasks;
+    sum->spawned       += stats->spawned;
+    sum->nodes         += stats->nodes;
+    sum->rejected_card += stats->rejected_card;
+    sum->subsets       += stats->subsets;
+    sum->contradicting += stats->contradicting;
+    sum->stored        += stats->stored;
+    sum->candidates    += stats->candidates;
+    sum->chooses       += stats->chooses;
+    sum->cpu_seconds   += stats->cpu_seconds;
+    if (sum->max_depth < stats->max_depth)
+    {
+        sum->max_depth = stats->max_depth;
+    }
+}		/* -----  end of function addSearchStats  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeSearchStats
+ *  Description:  writes counters of stats as members of a json object
+ * =====================================================================================
+ */
+    void
+writeSearchStats(FILE* out, struct search_stats* stats)
+{
+    fprintf(out, "\"tasks\": %lu, \"spawned\": %lu, \"nodes\": %lu, "
+            "\"max_depth\": %lu, \"rejected_card\": %lu, \"subsets\": %lu, "
+            "\"contradicting\": %lu, \"stored\": %lu, \"candidates\": %lu, "
+            "\"choose_calls\": %lu, \"cpu_seconds\": %.6f", stats->tasks,
+            stats->spawned, stats->nodes, stats->max_depth,
+            stats->rejected_card, stats->subsets, stats->contradicting,
+            stats->stored, stats->candidates, stats->chooses,
+            stats->cpu_seconds);
+}		/* -----  end of function writeSearchStats  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  writeStatsReport
+ *  Description:  writes json report of the counters of thread_count threads
+ *                for the mcs of card_count cardinalities
+ *                stats of thread t and cardinality card are stored at
+ *                stats[t * card_count + card], mcs of cardinality card + 1
+ *                are counted in mcs_counts[card], wall_seconds[card] is the
+ *                wall time until the cutsets of card + 1 deletions were
+ *                known, it is written as result_seconds
+ *                kernel_name is the bitset kernel used by the search
+ *                arena_peaks[t] is the peak frame memory of thread t
+ * =====================================================================================
+ */
+    void
+writeStatsReport(FILE* out, struct search_stats* stats, int thread_count,
+        int card_count, unsigned long* mcs_counts, double* wall_seconds,
+        char* kernel_name, size_t* arena_peaks)
+{
+    struct search_stats total;
+    memset(&total, 0, sizeof(struct search_stats));
+    fprintf(out, "{\n  \"threads\": %d,\n  \"max_card\": %d,\n"
+            "  \"kernel\": \"%s\",\n  \"cardinalities\": [", thread_count,
+            card_count, kernel_name);
+    int card;
+    int t;
+    for (card = 0; card < card_count; card++)
+    {
+        struct search_stats sum;
+        memset(&sum, 0, sizeof(struct search_stats));
+        for (t = 0; t < thread_count; t++)
+        {
+            addSearchStats(&sum, &stats[t * card_count + card]);
+        }
+        addSearchStats(&total, &sum);
+        fprintf(out, "%s\n    {\"mcs_card\": %d, \"mcs\": %lu, "
+                "\"result_seconds\": %.6f, ", card ? "," : "", card + 1,
+                mcs_counts[card], wall_seconds[card]);
+        writeSearchStats(out, &sum);
+        fprintf(out, ",\n     \"per_thread\": [");
+        for (t = 0; t < thread_count; t++)
+        {
+            fprintf(out, "%s\n       {\"thread\": %d, ", t ? "," : "", t);
+            writeSearchStats(out, &stats[t * card_count + card]);
+            fprintf(out, "}");
+        }
+        fprintf(out, "\n     ]}");
+    }
+    fprintf(out, "\n  ],\n  \"peak_frame_kb\": [");
+    for (t = 0; t < thread_count; t++)
+    {
+        fprintf(out, "%s%lu", t ? ", " : "", (unsigned long)(arena_peaks[t] /
+                    1024));
+    }
+    fprintf(out, "],\n  \"total\": {\"wall_seconds\": %.6f, ",
+            card_count ? wall_seconds[card_count - 1] : 0);
+    writeSearchStats(out, &total);
+    fprintf(out, "}\n}\n");
+}		/* -----  end of function writeStatsReport  ----- */
@@ -0,0 +1,494 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <pthread.h>
+#include <time.h>
+
+#define TASK_DEQUE_INIT   64
+#define TASK_RESULT_LOCKS 64
+
+// part of the cutset search that can be executed by any thread
+// the value of the subtree is added with sign to cutsets of mcs root
+struct cutset_task
+{
+    unsigned long  mcs_index;
+    unsigned long  root;
+    int            group;
+    int            sign;
+    int            is_root;
+    bitword*       active;
+    bitword*       stored;
+    uint128*       cutsets;
+};
+
+// tasks of one thread
+// the owner works at the tail, other threads steal from the head
+// head and tail are changed under lock but read without it to skip empty
+// deques, so they are always written atomically
+struct task_deque
+{
+    pthread_mutex_t     lock;
+    struct cutset_task* tasks;
+    unsigned long       head;
+    unsigned long       tail;
+    unsigned long       capacity;
+};
+
+// work-stealing pool with one deque per thread
+// tasks belong to groups whose completion can be awaited
+// idle workers sleep on work_ready until a task is pushed or all are done
+// results shared by several tasks are protected by striped locks
+struct task_pool
+{
+    int                worker_count;
+    struct task_deque* deques;
+    unsigned long      pending;
+    int                idle;
+    pthread_mutex_t    work_lock;
+    pthread_cond_t     work_ready;
+    int                group_count;
+    unsigned long*     group_pending;
+    pthread_mutex_t    group_lock;
+    pthread_cond_t     group_done;
+    pthread_mutex_t    result_lock[TASK_RESULT_LOCKS];
+};
+
+int initTaskPool(struct task_pool* pool, int worker_count, int group_count);
+void freeTaskPool(struct task_pool* pool);
+int pushTask(struct task_pool* pool, int worker_id, struct cutset_task* task);
+int popTask(struct task_pool* pool, int worker_id, struct cutset_task* task);
+int stealTask(struct task_pool* pool, int worker_id, struct cutset_task* task);
+void finishTask(struct task_pool* pool, struct cutset_task* task);
+void waitForGroups(struct task_pool* pool, int group_count);
+int waitForGroupsTimed(struct task_pool* pool, int group_count, int seconds);
+pthread_mutex_t* getResultLock(struct task_pool* pool, void* result);
+int wantsTask(struct task_pool* pool, int worker_id);
+int hasStealableTask(struct task_pool* pool, int worker_id);
+int getNextTask(struct task_pool* pool, int worker_id, struct cutset_task* task);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initTaskPool
+ *  Description:  prepares an empty deque for each worker and a counter of
+ *                pending tasks for each group
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+initTaskPool(struct task_pool* pool, int worker_count, int group_count)
+{
+    pool->worker_count  = worker_count;
+    pool->pending       = 0;
+    pool->idle          = 0;
+    pool->group_count   = group_count;
+    pool->deques        = calloc(worker_count, sizeof(struct task_deque));
+    pool->group_pending = calloc(group_count > 0 ? group_count : 1,
+            sizeof(unsigned long));
+    if ( (NULL == pool->deques) || (NULL == pool->group_pending) )
+    {
+        return 0;
+    }
+    pthread_mutex_init(&pool->group_lock, NULL);
+    pthread_cond_init(&pool->group_done, NULL);
+    pthread_mutex_init(&pool->work_lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    int i;
+    for (i = 0; i < TASK_RESULT_LOCKS; i++)
+    {
+        pthread_mutex_init(&pool->result_lock[i], NULL);
+    }
+    for (i = 0; i < worker_count; i++)
+    {
+        pthread_mutex_init(&pool->deques[i].lock, NULL);
+        pool->deques[i].capacity = TASK_DEQUE_INIT;
+        pool->deques[i].tasks    = malloc(TASK_DEQUE_INIT *
+                sizeof(struct cutset_task));
+        if (NULL == pool->deques[i].tasks)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}		/* -----  end of function initTaskPool  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeTaskPool
+ *  Description:  frees memory of all deques
+ * =====================================================================================
+ */
+    void
+freeTaskPool(struct task_pool* pool)
+{
+    int i;
+    for (i = 0; i < pool->worker_count; i++)
+    {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+        free(pool->deques[i].tasks);
+    }
+    free(pool->deques);
+    free(pool->group_pending);
+    pthread_mutex_destroy(&pool->group_lock);
+    pthread_cond_destroy(&pool->group_done);
+    pthread_mutex_destroy(&pool->work_lock);
+    pthread_cond_destroy(&pool->work_ready);
+    for (i = 0; i < TASK_RESULT_LOCKS; i++)
+    {
+        pthread_mutex_destroy(&pool->result_lock[i]);
+    }
+    pool->deques        = NULL;
+    pool->group_pending = NULL;
+}		/* -----  end of function freeTaskPool  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  pushTask
+ *  Description:  adds a task to the tail of the deque of worker_id and wakes
+ *                up an idle worker to steal it
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+pushTask(struct task_pool* pool, int worker_id, struct cutset_task* task)
+{
+    // count task before it is visible to avoid early termination
+    __atomic_add_fetch(&pool->pending, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&pool->group_pending[task->group], 1,
+            __ATOMIC_SEQ_CST);
+
+    struct task_deque* deque = &pool->deques[worker_id];
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail == deque->capacity)
+    {
+        if (deque->head > 0)
+        {
+            memmove(deque->tasks, deque->tasks + deque->head, (deque->tail -
+                        deque->head) * sizeof(struct cutset_task));
+            __atomic_store_n(&deque->tail, deque->tail - deque->head,
+                    __ATOMIC_RELAXED);
+            __atomic_store_n(&deque->head, 0, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            struct cutset_task* tasks = realloc(deque->tasks, 2 *
+                    deque->capacity * sizeof(struct cutset_task));
+            if (NULL == tasks)
+            {
+                pthread_mutex_unlock(&deque->lock);
+                return 0;
+            }
+            deque->tasks     = tasks;
+            deque->capacity *= 2;
+        }
+    }
+    deque->tasks[deque->tail] = *task;
+    // publish the task before idle is read, see getNextTask
+    __atomic_store_n(&deque->tail, deque->tail + 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&deque->lock);
+    if (__atomic_load_n(&pool->idle, __ATOMIC_SEQ_CST) > 0)
+    {
+        pthread_mutex_lock(&pool->work_lock);
+        pthread_cond_signal(&pool->work_ready);
+        pthread_mutex_unlock(&pool->work_lock);
+    }
+    return 1;
+}		/* -----  end of function pushTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  popTask
+ *  Description:  takes the newest task of the own deque
+ *                returns 0 if the deque is empty
+ * =====================================================================================
+ */
+    int
+popTask(struct task_pool* pool, int worker_id, struct cutset_task* task)
+{
+    int found = 0;
+    struct task_deque* deque = &pool->deques[worker_id];
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail > deque->head)
+    {
+        __atomic_store_n(&deque->tail, deque->tail - 1, __ATOMIC_RELAXED);
+        *task = deque->tasks[deque->tail];
+        found = 1;
+    }
+    if (deque->tail == deque->head)
+    {
+        __atomic_store_n(&deque->head, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&deque->tail, 0, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}		/* -----  end of function popTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  stealTask
+ *  Description:  takes the oldest task of the deque of another worker
+ *                returns 0 if all other deques are empty
+ * =====================================================================================
+ */
+    int
+stealTask(struct task_pool* pool, int worker_id, struct cutset_task* task)
+{
+    int i;
+    for (i = 1; i < pool->worker_count; i++)
+    {
+        struct task_deque* deque = &pool->deques[(worker_id + i) %
+            pool->worker_count];
+        // skip empty deques without locking
+        if (__atomic_load_n(&deque->tail, __ATOMIC_RELAXED) ==
+                __atomic_load_n(&deque->head, __ATOMIC_RELAXED))
+        {
+            continue;
+        }
+        int found = 0;
+        pthread_mutex_lock(&deque->lock);
+        if (deque->tail > deque->head)
+        {
+            *task = deque->tasks[deque->head];
+            __atomic_store_n(&deque->head, deque->head + 1, __ATOMIC_RELAXED);
+            found = 1;
+        }
+        pthread_mutex_unlock(&deque->lock);
+        if (found)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function stealTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  finishTask
+ *  Description:  marks a task as done and wakes up threads waiting for its
+ *                group if it was the last task of the group and idle workers
+ *                if it was the last task of all
+ * =====================================================================================
+ */
+    void
+finishTask(struct task_pool* pool, struct cutset_task* task)
+{
+    if (__atomic_sub_fetch(&pool->group_pending[task->group], 1,
+                __ATOMIC_SEQ_CST) == 0)
+    {
+        pthread_mutex_lock(&pool->group_lock);
+        pthread_cond_broadcast(&pool->group_done);
+        pthread_mutex_unlock(&pool->group_lock);
+    }
+    if (__atomic_sub_fetch(&pool->pending, 1, __ATOMIC_SEQ_CST) == 0)
+    {
+        pthread_mutex_lock(&pool->work_lock);
+        pthread_cond_broadcast(&pool->work_ready);
+        pthread_mutex_unlock(&pool->work_lock);
+    }
+}		/* -----  end of function finishTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  waitForGroups
+ *  Description:  waits until all tasks of groups 0 to group_count - 1 are done
+ * =====================================================================================
+ */
+    void
+waitForGroups(struct task_pool* pool, int group_count)
+{
+    if (group_count > pool->group_count)
+    {
+        group_count = pool->group_count;
+    }
+    pthread_mutex_lock(&pool->group_lock);
+    int g = 0;
+    while (g < group_count)
+    {
+        if (__atomic_load_n(&pool->group_pending[g], __ATOMIC_SEQ_CST) > 0)
+        {
+            pthread_cond_wait(&pool->group_done, &pool->group_lock);
+        }
+        else
+        {
+            g++;
+        }
+    }
+    pthread_mutex_unlock(&pool->group_lock);
+}		/* -----  end of function waitForGroups  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  waitForGroupsTimed
+ *  Description:  waits at most seconds until all tasks of groups 0 to
+ *                group_count - 1 are done
+ *                returns 1 if the groups are done
+ * =====================================================================================
+ */
+    int
+waitForGroupsTimed(struct task_pool* pool, int group_count, int seconds)
+{
+    if (group_count > pool->group_count)
+    {
+        group_count = pool->group_count;
+    }
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_sec += seconds;
+    pthread_mutex_lock(&pool->group_lock);
+    int g = 0;
+    while (g < group_count)
+    {
+        if (__atomic_load_n(&pool->group_pending[g], __ATOMIC_SEQ_CST) == 0)
+        {
+            g++;
+        }
+        else if (pthread_cond_timedwait(&pool->group_done, &pool->group_lock,
+                    &until))
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->group_lock);
+    return g >= group_count;
+}		/* -----  end of function waitForGroupsTimed  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  wantsTask
+ *  Description:  returns 1 if other workers are idle and the own deque holds
+ *                no task they could steal
+ * =====================================================================================
+ */
+    int
+wantsTask(struct task_pool* pool, int worker_id)
+{
+    struct task_deque* deque = &pool->deques[worker_id];
+    return __atomic_load_n(&pool->idle, __ATOMIC_RELAXED) > 0 &&
+        __atomic_load_n(&deque->tail, __ATOMIC_RELAXED) ==
+        __atomic_load_n(&deque->head, __ATOMIC_RELAXED);
+}		/* -----  end of function wantsTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  hasStealableTask
+ *  Description:  returns 1 if the deque of any other worker holds a task
+ * =====================================================================================
+ */
+    int
+hasStealableTask(struct task_pool* pool, int worker_id)
+{
+    int i;
+    for (i = 1; i < pool->worker_count; i++)
+    {
+        struct task_deque* deque = &pool->deques[(worker_id + i) %
+            pool->worker_count];
+        if (__atomic_load_n(&deque->tail, __ATOMIC_SEQ_CST) !=
+                __atomic_load_n(&deque->head, __ATOMIC_SEQ_CST))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function hasStealableTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getNextTask
+ *  Description:  returns next task of the own deque or steals one
+ *                sleeps while other workers may still create tasks
+ *                the worker is counted as idle before the deques are checked
+ *                under work_lock, so pushTask either sees it idle and wakes
+ *                it or the pushed task is found before it sleeps
+ *                returns 0 if all tasks are done
+ * =====================================================================================
+ */
+    int
+getNextTask(struct task_pool* pool, int worker_id, struct cutset_task* task)
+{
+    if (popTask(pool, worker_id, task) || stealTask(pool, worker_id, task))
+    {
+        return 1;
+    }
+    __atomic_add_fetch(&pool->idle, 1, __ATOMIC_SEQ_CST);
+    int found = 0;
+    pthread_mutex_lock(&pool->work_lock);
+    while (__atomic_load_n(&pool->pending, __ATOMIC_SEQ_CST) > 0)
+    {
+        if (!hasStealableTask(pool, worker_id))
+        {
+            pthread_cond_wait(&pool->work_ready, &pool->work_lock);
+            continue;
+        }
+        pthread_mutex_unlock(&pool->work_lock);
+        found = stealTask(pool, worker_id, task);
+        pthread_mutex_lock(&pool->work_lock);
+        if (found)
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->work_lock);
+    __atomic_sub_fetch(&pool->idle, 1, __ATOMIC_SEQ_CST);
+    return found;
+}		/* -----  end of function getNextTask  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getResultLock
+ *  Description:  returns lock protecting the result at the given address
+ * =====================================================================================
+ */
+    pthread_mutex_t*
+getResultLock(struct task_pool* pool, void* result)
+{
+    return &pool->result_lock[((uintptr_t)result / 64) % TASK_RESULT_LOCKS];
+}		/* -----  end of function getResultLock  ----- */
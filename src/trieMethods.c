@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define TRIE_NONE UINT32_MAX
+
+// node of a set trie, the path from the root to a node is an ascending list
+// of reactions, children of a node are sorted by reaction
+struct trie_node
+{
+    uint32_t rx;
+    uint32_t min_id;
+    uint32_t end_id;
+    uint32_t first_child;
+    uint32_t next_sibling;
+};
+
+// set trie of the rows of a reduced mcs matrix
+//   - end_id is the id of the mcs ending in a node
+//   - min_id is the lowest id of all mcs ending in the subtree of a node
+//   - the first nodes are found by reaction in root_child
+struct set_trie
+{
+    struct trie_node* nodes;
+    uint32_t          node_count;
+    uint32_t          node_size;
+    uint32_t*         root_child;
+    int               rx_count;
+};
+
+int initSetTrie(struct set_trie* trie, bitword* mat, unsigned long mcs_count,
+        int rx_count, int word_count);
+void freeSetTrie(struct set_trie* trie);
+int insertTrieSet(struct set_trie* trie, bitword* row, int word_count,
+        uint32_t id);
+uint32_t newTrieNode(struct set_trie* trie, uint32_t rx, uint32_t id);
+int trieHasSubset(struct set_trie* trie, const int* set, int set_count,
+        unsigned long limit);
+int trieHasSubsetBelow(struct set_trie* trie, uint32_t node_ix, const int*
+        set, int set_count, int pos, uint32_t limit);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  newTrieNode
+ *  Description:  appends a node without children to the trie
+ *                returns TRIE_NONE if there is not enough free memory
+ * =====================================================================================
+ */
+    uint32_t
+newTrieNode(struct set_trie* trie, uint32_t rx, uint32_t id)
+{
+    if (trie->node_count == trie->node_size)
+    {
+        uint32_t          size  = trie->node_size ? 2 * trie->node_size : 1024;
+        struct trie_node* nodes = realloc(trie->nodes, size *
+                sizeof(struct trie_node));
+        if ( (NULL == nodes) || (size <= trie->node_size) )
+        {
+            return TRIE_NONE;
+        }
+        trie->nodes     = nodes;
+        trie->node_size = size;
+    }
+    struct trie_node* node = &trie->nodes[trie->node_count];
+    node->rx           = rx;
+    node->min_id       = id;
+    node->end_id       = TRIE_NONE;
+    node->first_child  = TRIE_NONE;
+    node->next_sibling = TRIE_NONE;
+    return trie->node_count++;
+}		/* -----  end of function newTrieNode  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initSetTrie
+ *  Description:  inserts the mcs_count rows of the slab mat with word_count
+ *                words per row into a set trie, mcs ids are row numbers
+ *                returns 0 if there is not enough free memory or the mcs ids
+ *                do not fit in 32 bit
+ * =====================================================================================
+ */
+    int
+initSetTrie(struct set_trie* trie, bitword* mat, unsigned long mcs_count,
+        int rx_count, int word_count)
+{
+    trie->nodes      = NULL;
+    trie->node_count = 0;
+    trie->node_size  = 0;
+    trie->rx_count   = rx_count;
+    trie->root_child = malloc((rx_count + 1) * sizeof(uint32_t));
+    if ( (NULL == trie->root_child) || (mcs_count >= TRIE_NONE) )
+    {
+        freeSetTrie(trie);
+        return 0;
+    }
+    int rx;
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        trie->root_child[rx] = TRIE_NONE;
+    }
+
+    unsigned long li;
+    for (li = 0; li < mcs_count; li++)
+    {
+        if (!insertTrieSet(trie, SLABROW(mat, li, word_count), word_count,
+                    li))
+        {
+            freeSetTrie(trie);
+            return 0;
+        }
+    }
+    return 1;
+}		/* -----  end of function initSetTrie  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  insertTrieSet
+ *  Description:  inserts the reactions of row with word_count words as mcs
+ *                id, ids need to be inserted in ascending order
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+insertTrieSet(struct set_trie* trie, bitword* row, int word_count, uint32_t
+        id)
+{
+    // ids are inserted in ascending order, so the first mcs passing a node
+    // defines min_id of the node
+    uint32_t node = TRIE_NONE;
+    int      w;
+    for (w = 0; w < word_count; w++)
+    {
+        bitword bits = row[w];
+        while (bits)
+        {
+            uint32_t rx    = w * WORDBITS + __builtin_ctzll(bits);
+            uint32_t prev  = TRIE_NONE;
+            uint32_t child = TRIE_NONE == node ? trie->root_child[rx] :
+                trie->nodes[node].first_child;
+            bits &= bits - 1;
+
+            // find child in sorted list of children
+            if (TRIE_NONE != node)
+            {
+                while ( (TRIE_NONE != child) &&
+                        (trie->nodes[child].rx < rx) )
+                {
+                    prev  = child;
+                    child = trie->nodes[child].next_sibling;
+                }
+            }
+            if ( (TRIE_NONE == child) || (trie->nodes[child].rx != rx) )
+            {
+                uint32_t next = child;
+                child = newTrieNode(trie, rx, id);
+                if (TRIE_NONE == child)
+                {
+                    return 0;
+                }
+                if (TRIE_NONE == node)
+                {
+                    trie->root_child[rx] = child;
+                }
+                else if (TRIE_NONE == prev)
+                {
+                    trie->nodes[child].next_sibling = next;
+                    trie->nodes[node].first_child   = child;
+                }
+                else
+                {
+                    trie->nodes[child].next_sibling = next;
+                    trie->nodes[prev].next_sibling  = child;
+                }
+            }
+            node = child;
+        }
+    }
+    if (TRIE_NONE != node)
+    {
+        trie->nodes[node].end_id = id;
+    }
+    return 1;
+}		/* -----  end of function insertTrieSet  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeSetTrie
+ *  Description:  frees memory of a set trie
+ * =====================================================================================
+ */
+    void
+freeSetTrie(struct set_trie* trie)
+{
+    free(trie->nodes);
+    free(trie->root_child);
+    trie->nodes      = NULL;
+    trie->root_child = NULL;
+    trie->node_count = 0;
+    trie->node_size  = 0;
+}		/* -----  end of function freeSetTrie  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  trieHasSubset
+ *  Description:  returns 1 if a mcs with id < limit is a subset of the
+ *                ascending list of reactions set
+ *                only nodes on paths of reactions of set are visited
+ * =====================================================================================
+ */
+    int
+trieHasSubset(struct set_trie* trie, const int* set, int set_count, unsigned
+        long limit)
+{
+    uint32_t id_limit = limit < TRIE_NONE ? limit : TRIE_NONE;
+    int      i;
+    for (i = 0; i < set_count; i++)
+    {
+        uint32_t child = trie->root_child[set[i]];
+        if ( (TRIE_NONE != child) && (trie->nodes[child].min_id < id_limit) &&
+                trieHasSubsetBelow(trie, child, set, set_count, i + 1,
+                    id_limit) )
+        {
+            return 1;
+        }
+    }
+    return 0;
+}		/* -----  end of function trieHasSubset  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  trieHasSubsetBelow
+ *  Description:  returns 1 if a mcs with id < limit ends in the subtree of
+ *                node_ix and the rest of its path is part of set[pos] ...
+ *                set[set_count - 1]
+ * =====================================================================================
+ */
+    int
+trieHasSubsetBelow(struct set_trie* trie, uint32_t node_ix, const int* set,
+        int set_count, int pos, uint32_t limit)
+{
+    if (trie->nodes[node_ix].end_id < limit)
+    {
+        return 1;
+    }
+    // merge sorted children with the sorted rest of set
+    uint32_t child = trie->nodes[node_ix].first_child;
+    while ( (TRIE_NONE != child) && (pos < set_count) )
+    {
+        struct trie_node* node = &trie->nodes[child];
+        if (node->rx < (uint32_t)set[pos])
+        {
+            child = node->next_sibling;
+        }
+        else if (node->rx > (uint32_t)set[pos])
+        {
+            pos++;
+        }
+        else
+        {
+            pos++;
+            if ( (node->min_id < limit) && trieHasSubsetBelow(trie, child,
+                        set, set_count, pos, limit) )
+            {
+                return 1;
+            }
+            child = node->next_sibling;
+        }
+    }
+    return 0;
+}		/* -----  end of function trieHasSubsetBelow  ----- */
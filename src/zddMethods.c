@@ -0,0 +1,843 @@
+///////////////////////////////////////////////////////////////////////////////
+// Author: Matthias P. Gerstl
+// Email: matthias.gerstl@acib.at
+// Company: Austrian Centre of Industrial Biotechnology (ACIB)
+// Web: http://www.acib.at
+// Copyright (C) 2015
+// Published unter GNU Public License V3
+///////////////////////////////////////////////////////////////////////////////
+// Basic Permissions.
+// 
+// All rights granted under this License are granted for the term of copyright
+// on the Program, and are irrevocable provided the stated conditions are met.
+// This License explicitly affirms your unlimited permission to run the
+// unmodified Program. The output from running a covered work is covered by
+// this License only if the output, given its content, constitutes a covered
+// work. This License acknowledges your rights of fair use or other equivalent,
+// as provided by copyright law.
+// 
+// You may make, run and propagate covered works that you do not convey,
+// without conditions so long as your license otherwise remains in force. You
+// may convey covered works to others for the sole purpose of having them make
+// modifications exclusively for you, or provide you with facilities for
+// running those works, provided that you comply with the terms of this License
+// in conveying all material for which you do not control copyright. Those thus
+// making or running the covered works for you must do so exclusively on your
+// behalf, under your direction and control, on terms that prohibit them from
+// making any copies of your copyrighted material outside their relationship
+// with you.
+// 
+// Disclaimer of Warranty.
+// 
+// THERE IS NO WARRANTY FOR THE PROGRAM, TO THE EXTENT PERMITTED BY APPLICABLE
+// LAW. EXCEPT WHEN OTHERWISE STATED IN WRITING THE COPYRIGHT HOLDERS AND/OR
+// OTHER PARTIES PROVIDE THE PROGRAM “AS IS” WITHOUT WARRANTY OF ANY KIND,
+// EITHER EXPRESSED OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. THE
+// ENTIRE RISK AS TO THE QUALITY AND PERFORMANCE OF THE PROGRAM IS WITH YOU.
+// SHOULD THE PROGRAM PROVE DEFECTIVE, YOU ASSUME THE COST OF ALL NECESSARY
+// SERVICING, REPAIR OR CORRECTION.
+// 
+// Limitation of Liability.
+// 
+// IN NO EVENT UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING WILL
+// ANY COPYRIGHT HOLDER, OR ANY OTHER PARTY WHO MODIFIES AND/OR CONVEYS THE
+// PROGRAM AS PERMITTED ABOVE, BE LIABLE TO YOU FOR DAMAGES, INCLUDING ANY
+// GENERAL, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE
+// OR INABILITY TO USE THE PROGRAM (INCLUDING BUT NOT LIMITED TO LOSS OF DATA
+// OR DATA BEING RENDERED INACCURATE OR LOSSES SUSTAINED BY YOU OR THIRD
+// PARTIES OR A FAILURE OF THE PROGRAM TO OPERATE WITH ANY OTHER PROGRAMS),
+// EVEN IF SUCH HOLDER OR OTHER PARTY HAS BEEN ADVISED OF THE POSSIBILITY OF
+// SUCH DAMAGES.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ZDD_OK           0
+#define ZDD_ERROR_RAM    2
+
+#define ZDD_EMPTY        0
+#define ZDD_BASE         1
+#define ZDD_OP_UNION     1
+#define ZDD_OP_UP        2
+#define ZDD_OP_RESTRICT  3
+#define ZDD_INIT_NODES   (1UL << 16)
+#define ZDD_INIT_CACHE   (1UL << 18)
+
+// node of a zero-suppressed decision diagram
+// lo holds the sets without var, hi the sets with var
+// nodes 0 (empty family) and 1 (family of the empty set) are terminals
+struct zdd_node
+{
+    uint32_t var;
+    uint32_t lo;
+    uint32_t hi;
+};
+
+// entry of the lossy operation cache, op 0 marks empty entries
+struct zdd_cache_entry
+{
+    uint32_t op;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+    uint32_t result;
+};
+
+// diagram over var_count variables, variable 0 is the top
+// nodes are unique by the unique table and children are always created
+// before their parents
+// nodes, unique table, cache and counts never take more than max_bytes
+struct zdd
+{
+    uint32_t                var_count;
+    struct zdd_node*        nodes;
+    unsigned long           node_count;
+    unsigned long           node_size;
+    uint32_t*               unique;
+    unsigned long           unique_size;
+    struct zdd_cache_entry* cache;
+    unsigned long           cache_size;
+    size_t                  max_bytes;
+    int                     error;
+};
+
+int initZdd(struct zdd* zdd, uint32_t var_count, size_t max_bytes);
+void freeZdd(struct zdd* zdd);
+size_t getZddBytes(struct zdd* zdd);
+uint32_t getZddNode(struct zdd* zdd, uint32_t var, uint32_t lo, uint32_t hi);
+uint32_t zddUnion(struct zdd* zdd, uint32_t a, uint32_t b);
+uint32_t zddRestrict(struct zdd* zdd, uint32_t family, uint32_t max_size);
+uint32_t zddUpClosure(struct zdd* zdd, uint32_t family, uint32_t var,
+        uint32_t max_size);
+int countZddSets(struct zdd* zdd, uint32_t root, int max_size, uint128*
+        counts);
+int countCutsetsByZdd(bitword* mat, unsigned long mcs_count, int rx_count,
+        int word_count, int max_card, size_t max_bytes, uint128* cutsets,
+        unsigned long* node_count);
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  initZdd
+ *  Description:  prepares a diagram holding the two terminals that may grow
+ *                up to max_bytes
+ *                returns 0 if there is not enough free memory
+ * =====================================================================================
+ */
+    int
+initZdd(struct zdd* zdd, uint32_t var_count, size_t max_bytes)
+{
+    zdd->var_count   = var_count;
+    zdd->node_count  = 2;
+    zdd->node_size   = ZDD_INIT_NODES;
+    zdd->unique_size = 2 * ZDD_INIT_NODES;
+    zdd->cache_size  = ZDD_INIT_CACHE;
+    zdd->max_bytes   = max_bytes;
+    zdd->error       = 0;
+    zdd->nodes       = NULL;
+    zdd->unique      = NULL;
+    zdd->cache       = NULL;
+    if (getZddBytes(zdd) > max_bytes)
+    {
+        return 0;
+    }
+    zdd->nodes       = malloc(zdd->node_size * sizeof(struct zdd_node));
+    zdd->unique      = calloc(zdd->unique_size, sizeof(uint32_t));
+    zdd->cache       = calloc(zdd->cache_size, sizeof(struct
+                zdd_cache_entry));
+    if ( (NULL == zdd->nodes) || (NULL == zdd->unique) || (NULL ==
+                zdd->cache) )
+    {
+        freeZdd(zdd);
+        return 0;
+    }
+    int i;
+    for (i = 0; i < 2; i++)
+    {
+        zdd->nodes[i].var = var_count;
+        zdd->nodes[i].lo  = i;
+        zdd->nodes[i].hi  = i;
+    }
+    return 1;
+}		/* -----  end of function initZdd  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  freeZdd
+ *  Description:  frees nodes, unique table and cache of the diagram
+ * =====================================================================================
+ */
+    void
+freeZdd(struct zdd* zdd)
+{
+    free(zdd->nodes);
+    free(zdd->unique);
+    free(zdd->cache);
+    zdd->nodes  = NULL;
+    zdd->unique = NULL;
+    zdd->cache  = NULL;
+}		/* -----  end of function freeZdd  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getZddBytes
+ *  Description:  returns memory of nodes, unique table and cache
+ * =====================================================================================
+ */
+    size_t
+getZddBytes(struct zdd* zdd)
+{
+    return zdd->node_size * sizeof(struct zdd_node) + zdd->unique_size *
+        sizeof(uint32_t) + zdd->cache_size * sizeof(struct zdd_cache_entry);
+}		/* -----  end of function getZddBytes  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  hashZddKey
+ *  Description:  returns hash of a node or an operation
+ * =====================================================================================
+ */
+    unsigned long
+hashZddKey(uint32_t a, uint32_t b, uint32_t c)
+{
+    uint64_t hash = ((uint64_t)a * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)b *
+            0xC2B2AE3D27D4EB4FULL) ^ ((uint64_t)c * 0x165667B19E3779F9ULL);
+    return hash ^ (hash >> 31);
+}		/* -----  end of function hashZddKey  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getZddCacheEntry
+ *  Description:  returns the cache entry of operation op of a, b and c
+ * =====================================================================================
+ */
+    struct zdd_cache_entry*
+getZddCacheEntry(struct zdd* zdd, uint32_t op, uint32_t a, uint32_t b,
+        uint32_t c)
+{
+    return &zdd->cache[(hashZddKey(a, b, c) + op) & (zdd->cache_size - 1)];
+}		/* -----  end of function getZddCacheEntry  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  lookupZddCache
+ *  Description:  returns 1 and sets result if operation op of a, b and c is
+ *                cached
+ * =====================================================================================
+ */
+    int
+lookupZddCache(struct zdd* zdd, uint32_t op, uint32_t a, uint32_t b,
+        uint32_t c, uint32_t* result)
+{
+    struct zdd_cache_entry* entry = getZddCacheEntry(zdd, op, a, b, c);
+    if ( (entry->op == op) && (entry->a == a) && (entry->b == b) &&
+            (entry->c == c) )
+    {
+        *result = entry->result;
+        return 1;
+    }
+    return 0;
+}		/* -----  end of function lookupZddCache  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  storeZddCache
+ *  Description:  stores result of operation op of a, b and c, the entry may
+ *                replace the result of another operation
+ * =====================================================================================
+ */
+    void
+storeZddCache(struct zdd* zdd, uint32_t op, uint32_t a, uint32_t b, uint32_t
+        c, uint32_t result)
+{
+    struct zdd_cache_entry* entry = getZddCacheEntry(zdd, op, a, b, c);
+    entry->op     = op;
+    entry->a      = a;
+    entry->b      = b;
+    entry->c      = c;
+    entry->result = result;
+}		/* -----  end of function storeZddCache  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  growZdd
+ *  Description:  doubles nodes, unique table and cache of the diagram
+ *                the cache is cleared as its results are only hints, it
+ *                is kept if the doubled one exceeds max_bytes
+ *                returns 0 if there is not enough free memory or the
+ *                doubled nodes and unique table exceed max_bytes
+ * =====================================================================================
+ */
+    int
+growZdd(struct zdd* zdd)
+{
+    size_t cache_bytes = zdd->cache_size * sizeof(struct zdd_cache_entry);
+    if (2 * getZddBytes(zdd) - cache_bytes > zdd->max_bytes)
+    {
+        return 0;
+    }
+    unsigned long    node_size = 2 * zdd->node_size;
+    struct zdd_node* nodes     = realloc(zdd->nodes, node_size *
+            sizeof(struct zdd_node));
+    if (NULL == nodes)
+    {
+        return 0;
+    }
+    zdd->nodes     = nodes;
+    zdd->node_size = node_size;
+
+    unsigned long unique_size = 2 * zdd->unique_size;
+    uint32_t*     unique      = calloc(unique_size, sizeof(uint32_t));
+    if (NULL == unique)
+    {
+        return 0;
+    }
+    unsigned long id;
+    for (id = 2; id < zdd->node_count; id++)
+    {
+        struct zdd_node* node = &zdd->nodes[id];
+        unsigned long slot = hashZddKey(node->var, node->lo, node->hi) &
+            (unique_size - 1);
+        while (unique[slot])
+        {
+            slot = (slot + 1) & (unique_size - 1);
+        }
+        unique[slot] = id;
+    }
+    free(zdd->unique);
+    zdd->unique      = unique;
+    zdd->unique_size = unique_size;
+
+    if (getZddBytes(zdd) + cache_bytes > zdd->max_bytes)
+    {
+        return 1;
+    }
+    struct zdd_cache_entry* cache = calloc(2 * zdd->cache_size,
+            sizeof(struct zdd_cache_entry));
+    if (NULL != cache)
+    {
+        free(zdd->cache);
+        zdd->cache       = cache;
+        zdd->cache_size *= 2;
+    }
+    return 1;
+}		/* -----  end of function growZdd  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getZddNode
+ *  Description:  returns the unique node of var with children lo and hi
+ *                nodes without sets containing var are suppressed
+ *                sets error and returns ZDD_EMPTY if there is not enough
+ *                free memory
+ * =====================================================================================
+ */
+    uint32_t
+getZddNode(struct zdd* zdd, uint32_t var, uint32_t lo, uint32_t hi)
+{
+    if (ZDD_EMPTY == hi)
+    {
+        return lo;
+    }
+    unsigned long slot = hashZddKey(var, lo, hi) & (zdd->unique_size - 1);
+    while (zdd->unique[slot])
+    {
+        struct zdd_node* node = &zdd->nodes[zdd->unique[slot]];
+        if ( (node->var == var) && (node->lo == lo) && (node->hi == hi) )
+        {
+            return zdd->unique[slot];
+        }
+        slot = (slot + 1) & (zdd->unique_size - 1);
+    }
+    if ( (zdd->node_count >= UINT32_MAX) || zdd->error )
+    {
+        zdd->error = 1;
+        return ZDD_EMPTY;
+    }
+    if (zdd->node_count == zdd->node_size)
+    {
+        if (!growZdd(zdd))
+        {
+            zdd->error = 1;
+            return ZDD_EMPTY;
+        }
+        slot = hashZddKey(var, lo, hi) & (zdd->unique_size - 1);
+        while (zdd->unique[slot])
+        {
+            slot = (slot + 1) & (zdd->unique_size - 1);
+        }
+    }
+    uint32_t id = zdd->node_count++;
+    zdd->nodes[id].var = var;
+    zdd->nodes[id].lo  = lo;
+    zdd->nodes[id].hi  = hi;
+    zdd->unique[slot]  = id;
+    return id;
+}		/* -----  end of function getZddNode  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  zddUnion
+ *  Description:  returns the union of families a and b
+ * =====================================================================================
+ */
+    uint32_t
+zddUnion(struct zdd* zdd, uint32_t a, uint32_t b)
+{
+    if (ZDD_EMPTY == a)
+    {
+        return b;
+    }
+    if ( (ZDD_EMPTY == b) || (a == b) )
+    {
+        return a;
+    }
+    if (a > b)
+    {
+        uint32_t t = a;
+        a = b;
+        b = t;
+    }
+    uint32_t result;
+    if (lookupZddCache(zdd, ZDD_OP_UNION, a, b, 0, &result))
+    {
+        return result;
+    }
+
+    // nodes may move while children are combined
+    uint32_t var_a = zdd->nodes[a].var;
+    uint32_t var_b = zdd->nodes[b].var;
+    if (var_a < var_b)
+    {
+        uint32_t hi = zdd->nodes[a].hi;
+        uint32_t lo = zddUnion(zdd, zdd->nodes[a].lo, b);
+        result = getZddNode(zdd, var_a, lo, hi);
+    }
+    else if (var_b < var_a)
+    {
+        uint32_t hi = zdd->nodes[b].hi;
+        uint32_t lo = zddUnion(zdd, a, zdd->nodes[b].lo);
+        result = getZddNode(zdd, var_b, lo, hi);
+    }
+    else
+    {
+        uint32_t b_hi = zdd->nodes[b].hi;
+        uint32_t a_hi = zdd->nodes[a].hi;
+        uint32_t lo   = zddUnion(zdd, zdd->nodes[a].lo, zdd->nodes[b].lo);
+        uint32_t hi   = zddUnion(zdd, a_hi, b_hi);
+        result = getZddNode(zdd, var_a, lo, hi);
+    }
+    storeZddCache(zdd, ZDD_OP_UNION, a, b, 0, result);
+    return result;
+}		/* -----  end of function zddUnion  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  zddRestrict
+ *  Description:  returns the sets of family with at most max_size variables
+ * =====================================================================================
+ */
+    uint32_t
+zddRestrict(struct zdd* zdd, uint32_t family, uint32_t max_size)
+{
+    while ( (0 == max_size) && (family > ZDD_BASE) )
+    {
+        family = zdd->nodes[family].lo;
+    }
+    if (family <= ZDD_BASE)
+    {
+        return family;
+    }
+    uint32_t result;
+    if (lookupZddCache(zdd, ZDD_OP_RESTRICT, family, max_size, 0, &result))
+    {
+        return result;
+    }
+    uint32_t var = zdd->nodes[family].var;
+    uint32_t hi  = zddRestrict(zdd, zdd->nodes[family].hi, max_size - 1);
+    uint32_t lo  = zddRestrict(zdd, zdd->nodes[family].lo, max_size);
+    result = getZddNode(zdd, var, lo, hi);
+    storeZddCache(zdd, ZDD_OP_RESTRICT, family, max_size, 0, result);
+    return result;
+}		/* -----  end of function zddRestrict  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  zddUpClosure
+ *  Description:  returns all sets of at most max_size of the variables var
+ *                to var_count - 1 that contain at least one set of family
+ *                - sets without var have to contain a set without var
+ *                - sets with var have to contain a set with or without var
+ *                  of at most max_size - 1 other variables
+ *                the sets of family have to have at most max_size variables
+ * =====================================================================================
+ */
+    uint32_t
+zddUpClosure(struct zdd* zdd, uint32_t family, uint32_t var, uint32_t
+        max_size)
+{
+    if ( (ZDD_EMPTY == family) || (var == zdd->var_count) || (0 ==
+                max_size) )
+    {
+        return family;
+    }
+    uint32_t result;
+    if (lookupZddCache(zdd, ZDD_OP_UP, family, var, max_size, &result))
+    {
+        return result;
+    }
+
+    uint32_t without = family;
+    uint32_t with    = ZDD_EMPTY;
+    if (zdd->nodes[family].var == var)
+    {
+        without = zdd->nodes[family].lo;
+        with    = zdd->nodes[family].hi;
+    }
+    uint32_t lo = zddUpClosure(zdd, without, var + 1, max_size);
+    with        = zddUnion(zdd, zddRestrict(zdd, without, max_size - 1),
+            with);
+    uint32_t hi = zddUpClosure(zdd, with, var + 1, max_size - 1);
+    result = getZddNode(zdd, var, lo, hi);
+    storeZddCache(zdd, ZDD_OP_UP, family, var, max_size, result);
+    return result;
+}		/* -----  end of function zddUpClosure  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  getZddSetCount
+ *  Description:  returns the number of sets of k variables of the node with
+ *                counts of the sizes first to last
+ * =====================================================================================
+ */
+    uint128
+getZddSetCount(uint128* count, int first, int last, int k)
+{
+    if ( (k < first) || (k > last) )
+    {
+        return 0;
+    }
+    return count[k - first];
+}		/* -----  end of function getZddSetCount  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  countZddSets
+ *  Description:  counts the sets of root by size up to max_size in one pass
+ *                from the terminals to root over the nodes below root
+ *                each node only counts the sizes from its smallest to its
+ *                largest set, most nodes near the terminals hold few sizes
+ *                counts[k] gets the number of sets of k variables
+ *                returns 0 if there is not enough free memory or the counts
+ *                and the diagram exceed max_bytes
+ * =====================================================================================
+ */
+    int
+countZddSets(struct zdd* zdd, uint32_t root, int max_size, uint128* counts)
+{
+    uint32_t* slots = malloc((root + 1) * sizeof(uint32_t));
+    uint32_t* stack = malloc((root + 1) * sizeof(uint32_t));
+    if ( (NULL == slots) || (NULL == stack) )
+    {
+        free(slots);
+        free(stack);
+        return 0;
+    }
+
+    // mark nodes below root, children have lower ids than their parents
+    memset(slots, 0xff, (root + 1) * sizeof(uint32_t));
+    unsigned long stack_count = 0;
+    unsigned long reached     = 0;
+    stack[stack_count++] = root;
+    slots[root]          = 0;
+    while (stack_count)
+    {
+        uint32_t id = stack[--stack_count];
+        if (id < 2)
+        {
+            continue;
+        }
+        uint32_t child[2] = { zdd->nodes[id].lo, zdd->nodes[id].hi };
+        int c;
+        for (c = 0; c < 2; c++)
+        {
+            if (slots[child[c]] == UINT32_MAX)
+            {
+                slots[child[c]]      = 0;
+                stack[stack_count++] = child[c];
+            }
+        }
+    }
+    uint32_t id;
+    for (id = 0; id <= root; id++)
+    {
+        if (slots[id] != UINT32_MAX)
+        {
+            slots[id] = reached++;
+        }
+    }
+    free(stack);
+
+    // sizes of the smallest and largest set below each node, the empty
+    // family has none, counts of slot s start at offsets[s]
+    int*           first   = malloc(reached * sizeof(int));
+    int*           last    = malloc(reached * sizeof(int));
+    unsigned long* offsets = malloc((reached + 1) * sizeof(unsigned long));
+    if ( (NULL == first) || (NULL == last) || (NULL == offsets) )
+    {
+        free(first);
+        free(last);
+        free(offsets);
+        free(slots);
+        return 0;
+    }
+    offsets[0] = 0;
+    for (id = 0; id <= root; id++)
+    {
+        uint32_t s = slots[id];
+        if (s == UINT32_MAX)
+        {
+            continue;
+        }
+        if (id < 2)
+        {
+            first[s] = id ? 0 : max_size + 1;
+            last[s]  = id ? 0 : -1;
+        }
+        else
+        {
+            uint32_t lo = slots[zdd->nodes[id].lo];
+            uint32_t hi = slots[zdd->nodes[id].hi];
+            first[s] = first[lo] < first[hi] + 1 ? first[lo] : first[hi] + 1;
+            last[s]  = last[lo] > last[hi] + 1 ? last[lo] : last[hi] + 1;
+            if (last[s] > max_size)
+            {
+                last[s] = max_size;
+            }
+        }
+        offsets[s + 1] = offsets[s] + (last[s] >= first[s] ? last[s] -
+                first[s] + 1 : 0);
+    }
+
+    size_t   bytes       = offsets[reached] * sizeof(uint128);
+    size_t   used        = getZddBytes(zdd) + reached * (2 * sizeof(int) +
+            sizeof(unsigned long) + sizeof(uint32_t));
+    uint128* node_counts = NULL;
+    if (used + bytes <= zdd->max_bytes)
+    {
+        node_counts = malloc(bytes > 0 ? bytes : sizeof(uint128));
+    }
+    if (NULL == node_counts)
+    {
+        free(first);
+        free(last);
+        free(offsets);
+        free(slots);
+        return 0;
+    }
+    for (id = 0; id <= root; id++)
+    {
+        uint32_t s = slots[id];
+        if ( (s == UINT32_MAX) || (last[s] < first[s]) )
+        {
+            continue;
+        }
+        uint128* count = node_counts + offsets[s];
+        if (id < 2)
+        {
+            count[0] = 1;
+            continue;
+        }
+        uint32_t lo = slots[zdd->nodes[id].lo];
+        uint32_t hi = slots[zdd->nodes[id].hi];
+        int k;
+        for (k = first[s]; k <= last[s]; k++)
+        {
+            count[k - first[s]] = getZddSetCount(node_counts + offsets[lo],
+                    first[lo], last[lo], k) + getZddSetCount(node_counts +
+                        offsets[hi], first[hi], last[hi], k - 1);
+        }
+    }
+    uint32_t s = slots[root];
+    int      k;
+    for (k = 0; k <= max_size; k++)
+    {
+        counts[k] = getZddSetCount(node_counts + offsets[s], first[s],
+                last[s], k);
+    }
+    free(node_counts);
+    free(first);
+    free(last);
+    free(offsets);
+    free(slots);
+    return 1;
+}		/* -----  end of function countZddSets  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  buildMcsZdd
+ *  Description:  returns the family of the mcs first to last - 1 as union
+ *                of halves, levels[rx] is the variable of reaction rx
+ * =====================================================================================
+ */
+    uint32_t
+buildMcsZdd(struct zdd* zdd, bitword* mat, unsigned long first, unsigned
+        long last, int word_count, uint32_t* levels, uint32_t* vars)
+{
+    if (last - first > 1)
+    {
+        unsigned long middle = first + (last - first) / 2;
+        uint32_t a = buildMcsZdd(zdd, mat, first, middle, word_count, levels,
+                vars);
+        uint32_t b = buildMcsZdd(zdd, mat, middle, last, word_count, levels,
+                vars);
+        return zddUnion(zdd, a, b);
+    }
+
+    // variables of the mcs in descending order, the chain is built from
+    // the bottom
+    bitword* row       = SLABROW(mat, first, word_count);
+    int      var_count = 0;
+    int      w;
+    for (w = 0; w < word_count; w++)
+    {
+        bitword bits = row[w];
+        while (bits)
+        {
+            uint32_t var = levels[w * WORDBITS + __builtin_ctzll(bits)];
+            int      i   = var_count++;
+            while ( (i > 0) && (vars[i - 1] < var) )
+            {
+                vars[i] = vars[i - 1];
+                i--;
+            }
+            vars[i] = var;
+            bits &= bits - 1;
+        }
+    }
+    uint32_t chain = ZDD_BASE;
+    int i;
+    for (i = 0; i < var_count; i++)
+    {
+        chain = getZddNode(zdd, vars[i], ZDD_EMPTY, chain);
+    }
+    return chain;
+}		/* -----  end of function buildMcsZdd  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  orderZddVariables
+ *  Description:  defines variables of the reactions of the mcs_count mcs of
+ *                the slab mat in descending order of their frequency
+ *                reaction order[v] gets variable levels[order[v]] = v
+ *                returns number of reactions that are part of a mcs
+ * =====================================================================================
+ */
+    int
+orderZddVariables(bitword* mat, unsigned long mcs_count, int rx_count, int
+        word_count, unsigned long* freq, uint32_t* order, uint32_t* levels)
+{
+    unsigned long li;
+    int           w;
+    for (li = 0; li < mcs_count; li++)
+    {
+        bitword* row = SLABROW(mat, li, word_count);
+        for (w = 0; w < word_count; w++)
+        {
+            bitword bits = row[w];
+            while (bits)
+            {
+                freq[w * WORDBITS + __builtin_ctzll(bits)]++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    int used_count = 0;
+    int rx;
+    for (rx = 0; rx < rx_count; rx++)
+    {
+        if (0 == freq[rx])
+        {
+            continue;
+        }
+        int i = used_count++;
+        while ( (i > 0) && (freq[order[i - 1]] < freq[rx]) )
+        {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = rx;
+    }
+    int v;
+    for (v = 0; v < used_count; v++)
+    {
+        levels[order[v]] = v;
+    }
+    return used_count;
+}		/* -----  end of function orderZddVariables  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  countCutsetsByZdd
+ *  Description:  counts the sets of d = 0 .. max_card of the rx_count
+ *                reactions that contain at least one of the mcs_count mcs
+ *                of the slab mat into cutsets[d]
+ *                - frequent reactions become the top variables
+ *                - the diagram only holds sets of at most max_card
+ *                  reactions
+ *                - reactions of no mcs are free and added by convolution
+ *                - diagram and counts take at most max_bytes
+ *                node_count gets the number of nodes of the diagram
+ *                returns ZDD_OK or ZDD_ERROR_RAM if there is not enough
+ *                free memory or max_bytes are exceeded
+ * =====================================================================================
+ */
+    int
+countCutsetsByZdd(bitword* mat, unsigned long mcs_count, int rx_count, int
+        word_count, int max_card, size_t max_bytes, uint128* cutsets,
+        unsigned long* node_count)
+{
+    unsigned long* freq   = calloc(rx_count + 1, sizeof(unsigned long));
+    uint32_t*      order  = malloc((rx_count + 1) * sizeof(uint32_t));
+    uint32_t*      levels = malloc((rx_count + 1) * sizeof(uint32_t));
+    uint32_t*      vars   = malloc((rx_count + 1) * sizeof(uint32_t));
+    uint128*       counts = calloc(max_card + 1, sizeof(uint128));
+    int            status = ZDD_ERROR_RAM;
+    struct zdd     zdd;
+    if ( (NULL != freq) && (NULL != order) && (NULL != levels) && (NULL !=
+                vars) && (NULL != counts) && initZdd(&zdd,
+                    orderZddVariables(mat, mcs_count, rx_count, word_count,
+                        freq, order, levels), max_bytes) )
+    {
+        uint32_t family = mcs_count ? buildMcsZdd(&zdd, mat, 0, mcs_count,
+                word_count, levels, vars) : ZDD_EMPTY;
+        uint32_t closure = zddUpClosure(&zdd, zddRestrict(&zdd, family,
+                    max_card), 0, max_card);
+        *node_count = zdd.node_count;
+        if (!zdd.error && countZddSets(&zdd, closure, max_card, counts))
+        {
+            // add subsets of the free reactions to each set
+            int free_count = rx_count - zdd.var_count;
+            int d;
+            int j;
+            for (d = 0; d <= max_card; d++)
+            {
+                cutsets[d] = 0;
+                for (j = 0; (j <= d) && (j <= free_count); j++)
+                {
+                    cutsets[d] += chooseExact(free_count, j) * counts[d - j];
+                }
+            }
+            status = ZDD_OK;
+        }
+        freeZdd(&zdd);
+    }
+    free(freq);
+    free(order);
+    free(levels);
+    free(vars);
+    free(counts);
+    return status;
+}		/* -----  end of function countCutsetsByZdd  ----- */